@@ -0,0 +1,415 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \file   any_state_machine.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ *
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         a type-erased state machine wrapper is implemented.
+ */
+
+#if (defined(_MSC_VER) && _MSC_VER > 1020)
+#pragma once
+#endif // _MSC_VER > 1020
+
+#ifndef BOOST_FSM_ANY_STATE_MACHINE_HPP_INCLUDED_
+#define BOOST_FSM_ANY_STATE_MACHINE_HPP_INCLUDED_
+
+#include <new>
+#include <string>
+#include <cstddef>
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/next.hpp>
+#include <boost/mpl/begin.hpp>
+#include <boost/mpl/end.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/contains.hpp>
+#include <boost/fsm/state_machine.hpp>
+
+#ifndef BOOST_FSM_ANY_STATE_MACHINE_BUFFER_SIZE
+//! The default size of the internal buffer of any_state_machine, in bytes
+#define BOOST_FSM_ANY_STATE_MACHINE_BUFFER_SIZE (8 * sizeof(void*))
+#endif // BOOST_FSM_ANY_STATE_MACHINE_BUFFER_SIZE
+
+namespace boost {
+
+namespace fsm {
+
+namespace aux {
+
+    //! Event processing entries of the virtual table of any_state_machine
+    template< typename RetValT, typename IteratorT, typename EndT >
+    struct any_state_machine_events :
+        public any_state_machine_events< RetValT, typename mpl::next< IteratorT >::type, EndT >
+    {
+    private:
+        //! Base type
+        typedef any_state_machine_events< RetValT, typename mpl::next< IteratorT >::type, EndT > base_type;
+
+    public:
+        //! Event type
+        typedef typename mpl::deref< IteratorT >::type event_type;
+        //! Event processing function type
+        typedef RetValT (*process_fun_t)(void*, event_type const&);
+
+    private:
+        //! Event processing function
+        process_fun_t m_pProcess;
+
+    protected:
+        //! The method fills the entries with functions of the ImplT implementation
+        template< typename ImplT >
+        void init_events()
+        {
+            m_pProcess = &ImplT::BOOST_NESTED_TEMPLATE process< event_type >;
+            base_type::BOOST_NESTED_TEMPLATE init_events< ImplT >();
+        }
+
+    public:
+        //! The method returns the event processing function, the argument is only used for overload resolution
+        using base_type::get_process;
+        BOOST_FSM_FORCEINLINE process_fun_t get_process(event_type const*) const
+        {
+            return m_pProcess;
+        }
+    };
+
+    template< typename RetValT, typename EndT >
+    struct any_state_machine_events< RetValT, EndT, EndT >
+    {
+    protected:
+        template< typename ImplT >
+        void init_events() {}
+
+    public:
+        void get_process() const;
+    };
+
+    //! The virtual table of any_state_machine
+    template< typename EventListT, typename RetValT >
+    struct any_state_machine_vtable :
+        public any_state_machine_events<
+            RetValT,
+            typename mpl::begin< EventListT >::type,
+            typename mpl::end< EventListT >::type
+        >
+    {
+        //! Destroys the state machine
+        void (*m_pDestroy)(void*);
+        //! Resets the state machine
+        void (*m_pReset)(void*);
+        //! Returns the current state identifier
+        state_id_t (*m_pGetCurrentStateID)(void const*);
+        //! Returns the current state name
+        std::string const& (*m_pGetCurrentStateName)(void const*);
+    };
+
+    //! Implementation of the virtual table of any_state_machine for a particular state machine type
+    template< typename StateMachineT, typename EventListT, typename RetValT, std::size_t BufferSizeV >
+    class any_state_machine_impl
+    {
+    public:
+        //! State machine type
+        typedef StateMachineT state_machine_type;
+        //! Virtual table type
+        typedef any_state_machine_vtable< EventListT, RetValT > vtable_type;
+        //! Buffer type
+        typedef aligned_storage< BufferSizeV > buffer_type;
+        //! The flag is true if the state machine is stored in the buffer and false if it is allocated in the heap
+        typedef mpl::bool_<
+            sizeof(state_machine_type) <= BufferSizeV
+            && alignment_of< state_machine_type >::value <= buffer_type::alignment
+        > is_stored_in_buffer;
+
+    private:
+        //! The virtual table
+        struct vtable :
+            public vtable_type
+        {
+            BOOST_FSM_NOINLINE vtable()
+            {
+                this->BOOST_NESTED_TEMPLATE init_events< any_state_machine_impl >();
+                this->m_pDestroy = &any_state_machine_impl::destroy;
+                this->m_pReset = &any_state_machine_impl::reset;
+                this->m_pGetCurrentStateID = &any_state_machine_impl::get_current_state_id;
+                this->m_pGetCurrentStateName = &any_state_machine_impl::get_current_state_name;
+            }
+        };
+
+        //! The only virtual table instance
+        static vtable const g_VTable;
+
+    public:
+        //! The method returns a reference to the only virtual table instance
+        static BOOST_FSM_FORCEINLINE vtable_type const& get_vtable()
+        {
+            return g_VTable;
+        }
+
+        //! The method default-constructs the state machine
+        static state_machine_type* construct(buffer_type& buf)
+        {
+            return construct(buf, is_stored_in_buffer());
+        }
+        //! The method copy-constructs the state machine
+        static state_machine_type* construct(buffer_type& buf, state_machine_type const& that)
+        {
+            return construct(buf, that, is_stored_in_buffer());
+        }
+
+        //! Event processing routine
+        template< typename EventT >
+        static RetValT process(void* p, EventT const& evt)
+        {
+            return static_cast< RetValT >(static_cast< state_machine_type* >(p)->process(evt));
+        }
+
+    private:
+        static state_machine_type* construct(buffer_type& buf, mpl::true_ const&)
+        {
+            return new (buf.address()) state_machine_type();
+        }
+        static state_machine_type* construct(buffer_type&, mpl::false_ const&)
+        {
+            return new state_machine_type();
+        }
+        static state_machine_type* construct(buffer_type& buf, state_machine_type const& that, mpl::true_ const&)
+        {
+            return new (buf.address()) state_machine_type(that);
+        }
+        static state_machine_type* construct(buffer_type&, state_machine_type const& that, mpl::false_ const&)
+        {
+            return new state_machine_type(that);
+        }
+
+        static void destroy(void* p, mpl::true_ const&)
+        {
+            static_cast< state_machine_type* >(p)->~state_machine_type();
+        }
+        static void destroy(void* p, mpl::false_ const&)
+        {
+            delete static_cast< state_machine_type* >(p);
+        }
+        static void destroy(void* p)
+        {
+            destroy(p, is_stored_in_buffer());
+        }
+
+        static void reset(void* p)
+        {
+            static_cast< state_machine_type* >(p)->reset();
+        }
+        static state_id_t get_current_state_id(void const* p)
+        {
+            return static_cast< state_machine_type const* >(p)->get_current_state_id();
+        }
+        static std::string const& get_current_state_name(void const* p)
+        {
+            return static_cast< state_machine_type const* >(p)->get_current_state_name();
+        }
+    };
+
+    //! Implementation of the virtual tables
+    template< typename StateMachineT, typename EventListT, typename RetValT, std::size_t BufferSizeV >
+    typename any_state_machine_impl< StateMachineT, EventListT, RetValT, BufferSizeV >::vtable const
+        any_state_machine_impl< StateMachineT, EventListT, RetValT, BufferSizeV >::g_VTable;
+
+} // namespace aux
+
+/*!
+*    \brief A type-erased state machine
+*
+*    The class can hold a state machine of any type that is able to process all events in the EventListT list.
+*    Every event is processed with a single indirect call through the virtual table that is generated
+*    for each state machine type, which in turn passes the event to the state machine dispatching routine.
+*    The state machine is stored in the internal buffer of BufferSizeV bytes, if it fits, or allocated
+*    in the heap otherwise. State machine return values must be convertible to RetValT.
+*/
+template<
+    typename EventListT,
+    typename RetValT = void,
+    std::size_t BufferSizeV = BOOST_FSM_ANY_STATE_MACHINE_BUFFER_SIZE
+>
+class any_state_machine :
+    private noncopyable
+{
+public:
+    //! Return type
+    typedef RetValT return_type;
+    //! Events type list
+    typedef EventListT events_type_list;
+
+private:
+    //! Virtual table type
+    typedef aux::any_state_machine_vtable< EventListT, RetValT > vtable_type;
+    //! Buffer type
+    typedef aligned_storage< BufferSizeV > buffer_type;
+
+private:
+    //! The virtual table of the stored state machine
+    vtable_type const* m_pVTable;
+    //! A pointer to the stored state machine
+    void* m_pMachine;
+    //! The internal buffer
+    buffer_type m_Buffer;
+
+public:
+    /*!
+    *    \brief Default constructor, creates an empty object
+    *    \throw None
+    */
+    any_state_machine() : m_pVTable(NULL), m_pMachine(NULL)
+    {
+    }
+    /*!
+    *    \brief Constructor, stores a copy of the state machine
+    *    \param machine The state machine to copy
+    *    \throw std::bad_alloc if the state machine does not fit into the buffer and memory allocation fails.
+    *           May also throw if the state machine copy constructor throws.
+    */
+    template< typename StateMachineT >
+    explicit any_state_machine(StateMachineT const& machine) : m_pVTable(NULL), m_pMachine(NULL)
+    {
+        typedef aux::any_state_machine_impl< StateMachineT, EventListT, RetValT, BufferSizeV > impl_type;
+        m_pMachine = impl_type::construct(m_Buffer, machine);
+        m_pVTable = &impl_type::get_vtable();
+    }
+    /*!
+    *    \brief Destructor, destroys the stored state machine
+    *    \throw None
+    */
+    ~any_state_machine()
+    {
+        clear();
+    }
+
+    /*!
+    *    \brief The method replaces the stored state machine with a default-constructed StateMachineT
+    *    \return A reference to the constructed state machine
+    *    \throw std::bad_alloc if the state machine does not fit into the buffer and memory allocation fails.
+    *           May also throw if the state machine default constructor throws, in which case the object is left empty.
+    */
+    template< typename StateMachineT >
+    StateMachineT& emplace()
+    {
+        typedef aux::any_state_machine_impl< StateMachineT, EventListT, RetValT, BufferSizeV > impl_type;
+        clear();
+        StateMachineT* const p = impl_type::construct(m_Buffer);
+        m_pMachine = p;
+        m_pVTable = &impl_type::get_vtable();
+        return *p;
+    }
+
+    /*!
+    *    \brief The method destroys the stored state machine, the object becomes empty
+    *    \throw None
+    */
+    void clear()
+    {
+        if (m_pVTable)
+        {
+            m_pVTable->m_pDestroy(m_pMachine);
+            m_pVTable = NULL;
+            m_pMachine = NULL;
+        }
+    }
+    /*!
+    *    \brief The method checks if the object does not hold a state machine
+    *    \throw None
+    */
+    bool empty() const
+    {
+        return (m_pVTable == NULL);
+    }
+
+    /*!
+    *    \brief Event processing routine
+    *    \pre The object is not empty
+    *    \param evt The event to pass to state machine, must be one of the events in the EventListT list
+    *    \return The result of the stored state machine process method, converted to RetValT
+    *    \throw May only throw if the stored state machine process method throws
+    */
+    template< typename EventT >
+    return_type process(EventT const& evt)
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< EventListT, EventT >::value));
+        BOOST_ASSERT(!empty());
+        return (m_pVTable->get_process(static_cast< EventT const* >(NULL)))(m_pMachine, evt);
+    }
+
+    /*!
+    *    \brief The method resets the stored state machine to its initial state
+    *    \pre The object is not empty
+    *    \throw None
+    */
+    void reset()
+    {
+        BOOST_ASSERT(!empty());
+        m_pVTable->m_pReset(m_pMachine);
+    }
+    /*!
+    *    \brief The method returns current state identifier of the stored state machine
+    *    \pre The object is not empty
+    *    \throw None
+    */
+    state_id_t get_current_state_id() const
+    {
+        BOOST_ASSERT(!empty());
+        return m_pVTable->m_pGetCurrentStateID(m_pMachine);
+    }
+    /*!
+    *    \brief The method returns current state name of the stored state machine
+    *    \pre The object is not empty
+    *    \throw Nothing unless state name construction throws
+    */
+    std::string const& get_current_state_name() const
+    {
+        BOOST_ASSERT(!empty());
+        return m_pVTable->m_pGetCurrentStateName(m_pMachine);
+    }
+
+    /*!
+    *    \brief An accessor to the stored state machine
+    *    \return A pointer to the stored state machine if it is of type StateMachineT, NULL otherwise
+    *    \throw None
+    */
+    template< typename StateMachineT >
+    StateMachineT* target()
+    {
+        typedef aux::any_state_machine_impl< StateMachineT, EventListT, RetValT, BufferSizeV > impl_type;
+        if (m_pVTable == &impl_type::get_vtable())
+            return static_cast< StateMachineT* >(m_pMachine);
+        else
+            return NULL;
+    }
+    /*!
+    *    \brief An accessor to the stored state machine
+    *    \return A pointer to the stored state machine if it is of type StateMachineT, NULL otherwise
+    *    \throw None
+    */
+    template< typename StateMachineT >
+    StateMachineT const* target() const
+    {
+        typedef aux::any_state_machine_impl< StateMachineT, EventListT, RetValT, BufferSizeV > impl_type;
+        if (m_pVTable == &impl_type::get_vtable())
+            return static_cast< StateMachineT const* >(m_pMachine);
+        else
+            return NULL;
+    }
+};
+
+} // namespace fsm
+
+} // namespace boost
+
+#endif // BOOST_FSM_ANY_STATE_MACHINE_HPP_INCLUDED_
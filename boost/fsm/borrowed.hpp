@@ -0,0 +1,231 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \file   borrowed.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ *
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         borrowed event arguments are implemented. Such arguments refer to the memory owned
+ *         by the user (e.g. a network receive buffer) and are not copied with the event.
+ */
+
+#if (defined(_MSC_VER) && _MSC_VER > 1020)
+#pragma once
+#endif // _MSC_VER > 1020
+
+#ifndef BOOST_FSM_BORROWED_HPP_INCLUDED_
+#define BOOST_FSM_BORROWED_HPP_INCLUDED_
+
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/fsm/detail/prologue.hpp>
+#include <boost/fsm/event.hpp>
+
+namespace boost {
+
+namespace fsm {
+
+namespace aux {
+
+    //! The default setting of the borrowed arguments lifetime checks
+    struct borrowed_lifetime_checks
+    {
+#if defined(BOOST_FSM_CHECK_BORROWED_LIFETIME)
+        BOOST_STATIC_CONSTANT(bool, value = true);
+#else
+        BOOST_STATIC_CONSTANT(bool, value = false);
+#endif // defined(BOOST_FSM_CHECK_BORROWED_LIFETIME)
+    };
+
+} // namespace aux
+
+template< bool CheckedV >
+class basic_borrow_scope;
+
+/*!
+*    \brief A view on the user's memory that may be passed as an event argument
+*
+*    The ViewT type is a non-owning view, such as string_view or span. Copying a borrowed
+*    argument copies the view only, the referred memory is never copied. If CheckedV is true,
+*    the views obtained from a scope assert that the scope has not been released on every access.
+*    The setting is a part of the type, so the translation units built with different settings
+*    do not link together instead of sharing objects of different layout.
+*/
+template< typename ViewT, bool CheckedV = aux::borrowed_lifetime_checks::value >
+class borrowed
+{
+    template< bool >
+    friend class basic_borrow_scope;
+
+public:
+    //! View type
+    typedef ViewT view_type;
+
+private:
+    //! The view
+    view_type m_View;
+    //! The generation counter of the scope the view was borrowed from
+    shared_ptr< const unsigned int > m_pGeneration;
+    //! The scope generation at the moment the view was borrowed
+    unsigned int m_Generation;
+
+public:
+    //! Default constructor. Constructs an empty view.
+    borrowed() : m_View(), m_Generation(0)
+    {
+    }
+    //! Constructor. The view lifetime is not checked.
+    explicit borrowed(view_type const& view) : m_View(view), m_Generation(0)
+    {
+    }
+
+    //! The method returns true if the referred memory is still available
+    bool is_valid() const
+    {
+        return (!m_pGeneration || *m_pGeneration == m_Generation);
+    }
+
+    //! Accessor to the view
+    view_type const& get() const
+    {
+        BOOST_ASSERT(is_valid());
+        return m_View;
+    }
+    //! Conversion to the view
+    operator view_type const& () const
+    {
+        return get();
+    }
+    //! Member access to the view
+    view_type const* operator-> () const
+    {
+        return &get();
+    }
+
+private:
+    //! Constructor for the views borrowed from a scope
+    borrowed(view_type const& view, shared_ptr< const unsigned int > const& generation) :
+        m_View(view),
+        m_pGeneration(generation),
+        m_Generation(*generation)
+    {
+    }
+};
+
+//! A view on the user's memory without the lifetime checks, it has the same size as the view
+template< typename ViewT >
+class borrowed< ViewT, false >
+{
+public:
+    //! View type
+    typedef ViewT view_type;
+
+private:
+    //! The view
+    view_type m_View;
+
+public:
+    //! Default constructor. Constructs an empty view.
+    borrowed() : m_View()
+    {
+    }
+    //! Constructor
+    explicit borrowed(view_type const& view) : m_View(view)
+    {
+    }
+
+    //! The method returns true if the referred memory is still available. The lifetime is not tracked, so the method always returns true.
+    bool is_valid() const { return true; }
+
+    //! Accessor to the view
+    view_type const& get() const { return m_View; }
+    //! Conversion to the view
+    operator view_type const& () const { return m_View; }
+    //! Member access to the view
+    view_type const* operator-> () const { return &m_View; }
+};
+
+/*!
+*    \brief A scope of the memory that is lent to events
+*
+*    The scope should be kept along with the memory, e.g. a receive buffer. The release method
+*    must be called when the memory is about to be reused, after that every view borrowed from the scope
+*    is considered dangling. The scope is not thread-safe.
+*/
+template< bool CheckedV >
+class basic_borrow_scope :
+    private noncopyable
+{
+private:
+    //! The generation counter, it is incremented on every release
+    shared_ptr< unsigned int > m_pGeneration;
+
+public:
+    //! Constructor
+    basic_borrow_scope() : m_pGeneration(new unsigned int(0)) {}
+    //! Destructor. Releases all borrowed views.
+    ~basic_borrow_scope() { release(); }
+
+    //! The method marks all views borrowed so far as dangling
+    void release() { ++*m_pGeneration; }
+
+    //! The method lends the view
+    template< typename ViewT >
+    borrowed< ViewT, CheckedV > borrow(ViewT const& view) const
+    {
+        return borrowed< ViewT, CheckedV >(view, m_pGeneration);
+    }
+};
+
+//! A scope of the memory that is lent to events without the lifetime checks, the scope is empty
+template< >
+class basic_borrow_scope< false > :
+    private noncopyable
+{
+public:
+    //! The method marks all views borrowed so far as dangling
+    void release() {}
+
+    //! The method lends the view
+    template< typename ViewT >
+    borrowed< ViewT, false > borrow(ViewT const& view) const
+    {
+        return borrowed< ViewT, false >(view);
+    }
+};
+
+//! A scope of the memory that is lent to events, with the default lifetime checks setting
+typedef basic_borrow_scope< aux::borrowed_lifetime_checks::value > borrow_scope;
+
+//! The function lends the view without the lifetime checks
+template< typename ViewT >
+inline borrowed< ViewT > borrow(ViewT const& view)
+{
+    return borrowed< ViewT >(view);
+}
+
+namespace aux {
+
+    //! The event accessors return the view of the borrowed arguments
+    template< typename ViewT, bool CheckedV >
+    struct event_arg_access< borrowed< ViewT, CheckedV > >
+    {
+        typedef ViewT const& reference;
+        typedef ViewT const& const_reference;
+
+        static ViewT const& unwrap(borrowed< ViewT, CheckedV > const& value) { return value.get(); }
+    };
+
+} // namespace aux
+
+} // namespace fsm
+
+} // namespace boost
+
+#endif // BOOST_FSM_BORROWED_HPP_INCLUDED_
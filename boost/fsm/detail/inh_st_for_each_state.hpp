@@ -0,0 +1,18 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ * 
+ * \file   inh_st_for_each_state.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ * 
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         a part of inherited_states class implementation resides.
+ */
+
+#define BOOST_FSM_STATE_TYPE() BOOST_PP_CAT(BOOST_PP_CAT(state, BOOST_PP_ITERATION()), _type)
+            visitor.BOOST_NESTED_TEMPLATE visit< BOOST_FSM_STATE_TYPE() >();
+#undef BOOST_FSM_STATE_TYPE
@@ -26,8 +26,8 @@
         
                 // Fill the state info and go on filling for other states
                 pStateInfo->Shift = pState - pRoot;
-                pStateInfo->pTypeInfo = &typeid(BOOST_FSM_STATE_TYPE());
-                pStateInfo->pGetStateName = (state_info::get_state_name_fun_t)&BOOST_FSM_STATE_TYPE()::get_state_name;
+                pStateInfo->pTypeInfo = &type_info_of< BOOST_FSM_STATE_TYPE() >();
+                pStateInfo->pName = &BOOST_FSM_STATE_TYPE()::get_state_name();
                 ++pStateInfo;
             }
 #undef BOOST_FSM_STATE_TYPE
@@ -14,6 +14,7 @@
  */
 
 #define BOOST_FSM_STATE_IMPL_TYPE() BOOST_PP_CAT(BOOST_PP_CAT(state, BOOST_PP_ITERATION()), _impl_type)
+#ifndef BOOST_NO_EXCEPTIONS
             try
             {
                 BOOST_FSM_STATE_IMPL_TYPE()::on_reset();
@@ -21,4 +22,7 @@
             catch(...)
             {
             }
+#else
+            BOOST_FSM_STATE_IMPL_TYPE()::on_reset();
+#endif // BOOST_NO_EXCEPTIONS
 #undef BOOST_FSM_STATE_IMPL_TYPE
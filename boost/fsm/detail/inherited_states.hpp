@@ -68,6 +68,15 @@
         {
 #define BOOST_PP_ITERATION_LIMITS (1, BOOST_PP_ITERATION())
 #define BOOST_PP_FILENAME_2 <boost/fsm/detail/inh_st_init_process_functions.hpp>
+#include BOOST_PP_ITERATE()
+        }
+
+        //! The method passes every state type to the visitor
+        template< typename VisitorT >
+        static BOOST_FSM_FORCEINLINE void for_each_state(VisitorT& visitor)
+        {
+#define BOOST_PP_ITERATION_LIMITS (1, BOOST_PP_ITERATION())
+#define BOOST_PP_FILENAME_2 <boost/fsm/detail/inh_st_for_each_state.hpp>
 #include BOOST_PP_ITERATE()
         }
     };
@@ -62,4 +62,19 @@
 #define BOOST_FSM_ASSUME(expr)
 #endif
 
+// Support for variadic events with perfect forwarding, may be disabled to use the boost::tuple-based events
+#if !defined(BOOST_FSM_NO_VARIADIC_EVENTS) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#define BOOST_FSM_HAS_VARIADIC_EVENTS
+#endif
+
+// Support for std::variant events
+#if !defined(BOOST_NO_CXX17_HDR_VARIANT) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+#define BOOST_FSM_HAS_VARIANT_EVENTS
+#endif
+
+// Lifetime checks of the borrowed event arguments, enabled in debug builds by default. The setting is a part of the borrowed types.
+#if !defined(BOOST_FSM_CHECK_BORROWED_LIFETIME) && !defined(BOOST_FSM_NO_BORROWED_LIFETIME_CHECK) && !defined(NDEBUG)
+#define BOOST_FSM_CHECK_BORROWED_LIFETIME
+#endif
+
 #endif // BOOST_FSM_DETAIL_PROLOGUE_HPP_INCLUDED_
@@ -0,0 +1,409 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \file   dynamic_state_machine.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ *
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         the state machine defined in run time is implemented.
+ */
+
+#if (defined(_MSC_VER) && _MSC_VER > 1020)
+#pragma once
+#endif // _MSC_VER > 1020
+
+#ifndef BOOST_FSM_DYNAMIC_STATE_MACHINE_HPP_INCLUDED_
+#define BOOST_FSM_DYNAMIC_STATE_MACHINE_HPP_INCLUDED_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <istream>
+#include <sstream>
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/fsm/state_machine.hpp>
+
+namespace boost {
+
+namespace fsm {
+
+//! Event identifiers type of the dynamic state machines
+typedef unsigned int event_id_t;
+
+/*!
+*    \brief The event type of the dynamic state machines
+*
+*    Unexpected events of the dynamic state machines are passed to the unexpected events handlers as objects of this type.
+*/
+struct dynamic_event
+{
+    //! Event identifier
+    event_id_t id;
+
+    //! Constructor
+    explicit dynamic_event(event_id_t ID) : id(ID) {}
+};
+
+//! The type that represents states of the dynamic state machines in the type information passed to unexpected events handlers
+struct dynamic_state {};
+
+/*!
+*    \brief The definition of a state machine that is created in run time
+*
+*    The definition holds the names of the states and events, which are identified by their indices, and the transition table.
+*    The table is stored in the compressed sparse row format: the transitions are grouped by the current state, and within
+*    the group of a state they are sorted by the event identifiers. The first added state is the initial state.
+*
+*    The definition may be loaded from a text with the following format. Every line contains one of the declarations:
+*
+*    state <name>
+*    event <name>
+*    transition <current state name> <event name> <next state name> [<action identifier>]
+*
+*    The states and events must be declared before they are used in transitions. The action identifier is a non-negative
+*    decimal number. Empty lines and the text after '#' are ignored.
+*/
+class dynamic_machine_definition
+{
+public:
+    //! A transition table cell
+    struct transition_type
+    {
+        //! The next state
+        state_id_t next_state;
+        //! The action identifier, 0 if the transition has no action
+        unsigned int action;
+    };
+
+private:
+    //! Names to identifiers map type
+    typedef std::map< std::string, unsigned int > ids_map;
+
+private:
+    //! State names
+    std::vector< std::string > m_StateNames;
+    //! Event names
+    std::vector< std::string > m_EventNames;
+    //! State name to identifier map
+    ids_map m_StateIds;
+    //! Event name to identifier map
+    ids_map m_EventIds;
+
+    //! The offsets of the first transition of every state, the last element is the total number of transitions
+    std::vector< unsigned int > m_RowOffsets;
+    //! The events of the transitions
+    std::vector< event_id_t > m_Events;
+    //! The transitions
+    std::vector< transition_type > m_Transitions;
+
+public:
+    //! Default constructor, creates an empty definition
+    dynamic_machine_definition() : m_RowOffsets(1u, 0u) {}
+    //! The constructor loads the definition from a stream
+    explicit dynamic_machine_definition(std::istream& strm) : m_RowOffsets(1u, 0u)
+    {
+        load(strm);
+    }
+
+    /*!
+    *    \brief The method adds a state
+    *    \return The identifier of the state
+    *    \throw bad_machine_definition If the state is already defined
+    */
+    state_id_t add_state(std::string const& name)
+    {
+        const state_id_t id = static_cast< state_id_t >(m_StateNames.size());
+        if (!m_StateIds.insert(ids_map::value_type(name, id)).second)
+            boost::throw_exception(bad_machine_definition("state '" + name + "' is already defined"));
+        m_StateNames.push_back(name);
+        m_RowOffsets.push_back(m_RowOffsets.back());
+        return id;
+    }
+    /*!
+    *    \brief The method adds an event
+    *    \return The identifier of the event
+    *    \throw bad_machine_definition If the event is already defined
+    */
+    event_id_t add_event(std::string const& name)
+    {
+        const event_id_t id = static_cast< event_id_t >(m_EventNames.size());
+        if (!m_EventIds.insert(ids_map::value_type(name, id)).second)
+            boost::throw_exception(bad_machine_definition("event '" + name + "' is already defined"));
+        m_EventNames.push_back(name);
+        return id;
+    }
+    /*!
+    *    \brief The method adds a transition
+    *    \throw bad_machine_definition If the identifiers are not valid or the transition for the state and the event is already defined
+    */
+    void add_transition(state_id_t current_state, event_id_t event, state_id_t next_state, unsigned int action = 0)
+    {
+        if (current_state >= states_count() || next_state >= states_count() || event >= events_count())
+            boost::throw_exception(bad_machine_definition("invalid state or event identifier in a transition"));
+
+        std::vector< event_id_t >::iterator
+            begin = m_Events.begin() + m_RowOffsets[current_state],
+            end = m_Events.begin() + m_RowOffsets[current_state + 1],
+            it = std::lower_bound(begin, end, event);
+        if (it != end && *it == event)
+        {
+            boost::throw_exception(bad_machine_definition(
+                "transition from state '" + m_StateNames[current_state] + "' on event '" + m_EventNames[event] + "' is already defined"));
+        }
+
+        const std::size_t pos = it - m_Events.begin();
+        transition_type transition = { next_state, action };
+        m_Events.insert(it, event);
+        m_Transitions.insert(m_Transitions.begin() + pos, transition);
+        for (std::size_t i = current_state + 1; i < m_RowOffsets.size(); ++i)
+            ++m_RowOffsets[i];
+    }
+
+    /*!
+    *    \brief The method loads the definition from the text
+    *
+    *    The declarations are added to the ones already in the definition.
+    *
+    *    \throw bad_machine_definition If the text is not a valid definition
+    */
+    void load(std::istream& strm)
+    {
+        std::string line;
+        for (unsigned int line_no = 1; std::getline(strm, line); ++line_no)
+        {
+            const std::string::size_type comment = line.find('#');
+            if (comment != std::string::npos)
+                line.erase(comment);
+
+            std::istringstream line_strm(line);
+            std::string keyword;
+            if (!(line_strm >> keyword))
+                continue;
+
+            std::string name;
+            if (keyword == "state" && (line_strm >> name))
+            {
+                if (!!find_state(name))
+                    boost::throw_exception(bad_machine_definition("state '" + name + "' is already defined", line_no));
+                add_state(name);
+            }
+            else if (keyword == "event" && (line_strm >> name))
+            {
+                if (!!find_event(name))
+                    boost::throw_exception(bad_machine_definition("event '" + name + "' is already defined", line_no));
+                add_event(name);
+            }
+            else if (keyword == "transition")
+            {
+                std::string event_name, next_name;
+                if (!(line_strm >> name >> event_name >> next_name))
+                    boost::throw_exception(bad_machine_definition("incomplete transition", line_no));
+                std::string action_str;
+                unsigned int action = 0;
+                if (line_strm >> action_str)
+                {
+                    // Only decimal digits are allowed, the stream would accept negative numbers
+                    std::istringstream action_strm(action_str);
+                    if (action_str[0] < '0' || action_str[0] > '9' || !(action_strm >> action) || !action_strm.eof())
+                        boost::throw_exception(bad_machine_definition("invalid action identifier", line_no));
+                }
+
+                const state_id_t current = get_state_id(name, line_no), next = get_state_id(next_name, line_no);
+                const event_id_t event = get_event_id(event_name, line_no);
+                if (find_transition(current, event))
+                {
+                    boost::throw_exception(bad_machine_definition(
+                        "transition from state '" + name + "' on event '" + event_name + "' is already defined", line_no));
+                }
+                add_transition(current, event, next, action);
+            }
+            else
+            {
+                boost::throw_exception(bad_machine_definition("invalid declaration", line_no));
+            }
+
+            if (line_strm >> name)
+                boost::throw_exception(bad_machine_definition("unexpected text after the declaration", line_no));
+        }
+
+        if (m_StateNames.empty())
+            boost::throw_exception(bad_machine_definition("no states are defined"));
+    }
+
+    //! The method returns the number of states
+    unsigned int states_count() const { return static_cast< unsigned int >(m_StateNames.size()); }
+    //! The method returns the number of events
+    unsigned int events_count() const { return static_cast< unsigned int >(m_EventNames.size()); }
+    //! The method returns the number of transitions
+    unsigned int transitions_count() const { return static_cast< unsigned int >(m_Transitions.size()); }
+
+    //! The method returns the state name
+    std::string const& get_state_name(state_id_t id) const
+    {
+        BOOST_ASSERT(id < states_count());
+        return m_StateNames[id];
+    }
+    //! The method returns the event name
+    std::string const& get_event_name(event_id_t id) const
+    {
+        BOOST_ASSERT(id < events_count());
+        return m_EventNames[id];
+    }
+    //! The method returns the state identifier or an empty value if there is no such state
+    optional< state_id_t > find_state(std::string const& name) const
+    {
+        ids_map::const_iterator it = m_StateIds.find(name);
+        if (it != m_StateIds.end())
+            return it->second;
+        else
+            return optional< state_id_t >();
+    }
+    //! The method returns the event identifier or an empty value if there is no such event
+    optional< event_id_t > find_event(std::string const& name) const
+    {
+        ids_map::const_iterator it = m_EventIds.find(name);
+        if (it != m_EventIds.end())
+            return it->second;
+        else
+            return optional< event_id_t >();
+    }
+
+    //! The method returns the transition for the state and the event or NULL if there is no such transition
+    BOOST_FSM_FORCEINLINE transition_type const* find_transition(state_id_t state, event_id_t event) const
+    {
+        BOOST_ASSERT(state < states_count());
+        event_id_t const* const pEvents = m_Events.empty() ? static_cast< event_id_t const* >(0) : &m_Events[0];
+        event_id_t const* const pBegin = pEvents + m_RowOffsets[state];
+        event_id_t const* const pEnd = pEvents + m_RowOffsets[state + 1];
+        event_id_t const* const p = std::lower_bound(pBegin, pEnd, event);
+        if (p != pEnd && *p == event)
+            return &m_Transitions[p - pEvents];
+        else
+            return 0;
+    }
+
+private:
+    //! The method returns the identifier of the state used in the definition text
+    state_id_t get_state_id(std::string const& name, unsigned int line_no) const
+    {
+        optional< state_id_t > id = find_state(name);
+        if (!id)
+            boost::throw_exception(bad_machine_definition("state '" + name + "' is not defined", line_no));
+        return id.get();
+    }
+    //! The method returns the identifier of the event used in the definition text
+    event_id_t get_event_id(std::string const& name, unsigned int line_no) const
+    {
+        optional< event_id_t > id = find_event(name);
+        if (!id)
+            boost::throw_exception(bad_machine_definition("event '" + name + "' is not defined", line_no));
+        return id.get();
+    }
+};
+
+/*!
+*    \brief A state machine that is defined in run time
+*
+*    The machine processes events identified by integers with the transition table of the shared definition.
+*    The unexpected events are processed the same way as in state_machine: if UnexpectedHandlerT is void,
+*    the handler is set in run time with set_unexpected_event_handler, otherwise UnexpectedHandlerT is
+*    an unexpected events handler policy, like ignore_unexpected_events. The handlers receive a dynamic_event object
+*    and the type information of dynamic_state.
+*/
+template< typename UnexpectedHandlerT = void >
+class dynamic_state_machine :
+    public aux::unexpected_event_handler_storage< void, UnexpectedHandlerT >
+{
+public:
+    //! Machine definition type
+    typedef dynamic_machine_definition definition_type;
+    //! Unexpected events handler policy
+    typedef UnexpectedHandlerT unexpected_handler_type;
+
+private:
+    //! Base type
+    typedef aux::unexpected_event_handler_storage< void, UnexpectedHandlerT > base_type;
+
+private:
+    //! The definition of the machine
+    shared_ptr< definition_type const > m_pDefinition;
+    //! The current state
+    state_id_t m_State;
+
+public:
+    //! Constructor
+    explicit dynamic_state_machine(shared_ptr< definition_type const > const& definition) :
+        m_pDefinition(definition),
+        m_State(0)
+    {
+        BOOST_ASSERT(m_pDefinition && m_pDefinition->states_count() > 0);
+    }
+    //! A constructor with unexpected events handler setup
+    template< typename T >
+    dynamic_state_machine(shared_ptr< definition_type const > const& definition, T const& handler) :
+        m_pDefinition(definition),
+        m_State(0)
+    {
+        BOOST_ASSERT(m_pDefinition && m_pDefinition->states_count() > 0);
+        base_type::set_unexpected_event_handler(handler);
+    }
+
+    /*!
+    *    \brief The method passes the event to the machine
+    *    \return The action identifier of the transition, 0 if the transition has no action or the event is unexpected
+    *    \throw unexpected_event If the event is unexpected and no handler is set
+    */
+    unsigned int process(event_id_t event)
+    {
+        BOOST_ASSERT(event < m_pDefinition->events_count());
+        definition_type::transition_type const* const p = m_pDefinition->find_transition(m_State, event);
+        if (p)
+        {
+            m_State = p->next_state;
+            return p->action;
+        }
+
+        invoke_unexpected_event_handler(dynamic_event(event), is_same< unexpected_handler_type, void >());
+        return 0;
+    }
+
+    //! The method resets the machine to the initial state
+    void reset() { m_State = 0; }
+
+    //! The method returns the definition of the machine
+    definition_type const& get_definition() const { return *m_pDefinition; }
+    //! The method returns the current state identifier
+    state_id_t get_current_state_id() const { return m_State; }
+    //! The method returns the current state name
+    std::string const& get_current_state_name() const { return m_pDefinition->get_state_name(m_State); }
+    //! The method checks if the machine is in the specified state
+    bool is_in_state(state_id_t state) const { return m_State == state; }
+
+private:
+    //! The method invokes the unexpected events handler set in run time
+    void invoke_unexpected_event_handler(dynamic_event const& evt, mpl::true_ const&)
+    {
+        base_type::on_unexpected_event(*this, evt, aux::type_info_of< dynamic_state >(), m_State);
+    }
+    //! The method invokes the statically configured unexpected events handler
+    void invoke_unexpected_event_handler(dynamic_event const& evt, mpl::false_ const&)
+    {
+        unexpected_handler_type::BOOST_NESTED_TEMPLATE on_unexpected_event< void >(evt, m_State);
+    }
+};
+
+} // namespace fsm
+
+} // namespace boost
+
+#endif // BOOST_FSM_DYNAMIC_STATE_MACHINE_HPP_INCLUDED_
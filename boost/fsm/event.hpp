@@ -21,19 +21,27 @@
 #define BOOST_FSM_EVENT_HPP_INCLUDED_
 
 #include <boost/ref.hpp>
-#include <boost/tuple/tuple.hpp>
 #include <boost/mpl/if.hpp>
 #include <boost/mpl/identity.hpp>
 #include <boost/mpl/int.hpp>
 #include <boost/type_traits/add_reference.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/fsm/detail/prologue.hpp>
+
+#if defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+#include <cstddef>
+#include <boost/mpl/eval_if.hpp>
+#include <boost/type_traits/decay.hpp>
+#else // defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
 #include <boost/preprocessor/cat.hpp>
 #include <boost/preprocessor/repetition/repeat.hpp>
 #include <boost/preprocessor/repetition/repeat_from_to.hpp>
+#include <boost/preprocessor/repetition/enum.hpp>
 #include <boost/preprocessor/repetition/enum_params.hpp>
 #include <boost/preprocessor/repetition/enum_trailing_params.hpp>
 #include <boost/preprocessor/repetition/enum_binary_params.hpp>
 #include <boost/preprocessor/repetition/enum_params_with_a_default.hpp>
-#include <boost/fsm/detail/prologue.hpp>
+#endif // defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
 
 #ifndef BOOST_FSM_MAX_EVENT_ARGS
 #define BOOST_FSM_MAX_EVENT_ARGS 10
@@ -43,6 +51,346 @@ namespace boost {
 
 namespace fsm {
 
+namespace aux {
+
+    /*!
+    *    \brief An internal mapper that transforms reference_wrapper into a real reference type
+    *           to ease fsm::event usage in the on_process handlers and transition rules
+    */
+    template< typename T >
+    struct event_arg_type :
+        public mpl::if_<
+            is_reference_wrapper< T >,
+            add_reference< typename unwrap_reference< T >::type >,
+            mpl::identity< T >
+        >::type
+    {
+    };
+
+    /*!
+    *    \brief An internal mapper of the stored fsm::event argument type to the type returned by the event accessors
+    *
+    *    The arguments are returned as is. The specializations may return a different type, e.g. the borrowed
+    *    arguments are returned as views.
+    */
+    template< typename T >
+    struct event_arg_access
+    {
+        typedef typename add_reference< T >::type reference;
+        typedef typename add_reference< T const >::type const_reference;
+
+        template< typename U >
+        static BOOST_FSM_FORCEINLINE U& unwrap(U& value) { return value; }
+    };
+
+} // namespace aux
+
+#if defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+
+namespace aux {
+
+    //! A sequence of the event argument indices
+    template< std::size_t... IndicesV >
+    struct event_indices
+    {
+    };
+
+    //! The metafunction makes the sequence of indices [0, CountV)
+    template< std::size_t CountV, std::size_t... IndicesV >
+    struct make_event_indices :
+        public make_event_indices< CountV - 1, CountV - 1, IndicesV... >
+    {
+    };
+    template< std::size_t... IndicesV >
+    struct make_event_indices< 0, IndicesV... >
+    {
+        typedef event_indices< IndicesV... > type;
+    };
+
+    //! The metafunction returns the type of the event argument with the specified index
+    template< std::size_t IndexV, typename... T >
+    struct event_arg_at;
+    template< typename HeadT, typename... T >
+    struct event_arg_at< 0, HeadT, T... >
+    {
+        typedef HeadT type;
+    };
+    template< std::size_t IndexV, typename HeadT, typename... T >
+    struct event_arg_at< IndexV, HeadT, T... > :
+        public event_arg_at< IndexV - 1, T... >
+    {
+    };
+
+    //! The tag of the constructors that initialize the event arguments with values
+    struct event_args_init {};
+    //! The tag of the constructors that initialize the event arguments with the tuple elements
+    struct event_tuple_init {};
+
+    //! The metafunction makes the tuple type
+    template< typename... T >
+    struct event_tuple_type
+    {
+        typedef tuple< T... > type;
+    };
+    //! The metafunction makes the tuple type of the event arguments, or void if boost::tuple cannot hold that many elements
+    template< typename... T >
+    struct event_tuple :
+        public mpl::eval_if_c<
+            (sizeof...(T) <= 10u),
+            event_tuple_type< T... >,
+            mpl::identity< void >
+        >
+    {
+    };
+
+    //! A single event argument, the index makes the bases of the arguments distinct
+    template< std::size_t IndexV, typename T >
+    struct event_field
+    {
+        //! The argument value
+        T m_Value;
+
+        //! Default constructor
+        event_field() : m_Value() {}
+        //! Constructor from the value
+        template< typename U >
+        event_field(event_args_init, U&& value) : m_Value(static_cast< U&& >(value)) {}
+    };
+
+    //! The storage of the event arguments
+    template< typename IndicesT, typename... T >
+    struct event_fields;
+    template< std::size_t... IndicesV, typename... T >
+    struct event_fields< event_indices< IndicesV... >, T... > :
+        public event_field< IndicesV, T >...
+    {
+        //! Default constructor
+        event_fields() {}
+        //! Constructor from the argument values
+        template< typename... ArgsT >
+        explicit event_fields(event_args_init, ArgsT&&... args) :
+            event_field< IndicesV, T >(event_args_init(), static_cast< ArgsT&& >(args))...
+        {
+        }
+        //! Constructor from the tuple elements
+        template< typename HeadT, typename TailT >
+        event_fields(event_tuple_init, tuples::cons< HeadT, TailT > const& that) :
+            event_field< IndicesV, T >(event_args_init(), tuples::get< IndicesV >(that))...
+        {
+        }
+
+        //! The method makes a tuple of references to the arguments
+        template< typename TupleT >
+        TupleT tie_fields()
+        {
+            return TupleT(static_cast< event_field< IndicesV, T >& >(*this).m_Value...);
+        }
+        //! The method makes a tuple of references to the arguments
+        template< typename TupleT >
+        TupleT tie_fields() const
+        {
+            return TupleT(static_cast< event_field< IndicesV, T > const& >(*this).m_Value...);
+        }
+    };
+
+    //! The arguments of an fsm::event
+    template< typename... T >
+    struct event_arguments :
+        public event_fields< typename make_event_indices< sizeof...(T) >::type, T... >
+    {
+    private:
+        //! Base type
+        typedef event_fields< typename make_event_indices< sizeof...(T) >::type, T... > base_type;
+
+    public:
+        //! Default constructor
+        event_arguments() {}
+        //! Constructor from the argument values
+        template< typename... ArgsT >
+        explicit event_arguments(event_args_init tag, ArgsT&&... args) :
+            base_type(tag, static_cast< ArgsT&& >(args)...)
+        {
+        }
+        //! Constructor from the tuple elements
+        template< typename HeadT, typename TailT >
+        event_arguments(event_tuple_init tag, tuples::cons< HeadT, TailT > const& that) :
+            base_type(tag, that)
+        {
+        }
+    };
+
+} // namespace aux
+
+/*!
+*    \brief Tagged event type
+*
+*    The event arguments are stored as direct members of the event, so accessing them does not involve any indirection.
+*    The event is movable if all its arguments are. For compatibility with the events implemented on top of boost::tuple,
+*    the events with up to 10 arguments can also be constructed from, assigned from and viewed as a tuple.
+*/
+template< typename TagT, typename... T >
+struct event :
+    public aux::event_arguments< T... >
+{
+    //! Tag type
+    typedef TagT tag_type;
+    //! Arguments type
+    typedef aux::event_arguments< T... > arguments_type;
+    //! Tuple type, void if there are too many arguments
+    typedef typename aux::event_tuple< T... >::type tuple_type;
+    //! Number of arguments
+    BOOST_STATIC_CONSTANT(std::size_t, arity = sizeof...(T));
+
+private:
+    //! The tuple of references to the arguments
+    typedef typename aux::event_tuple< typename add_reference< T >::type... >::type tuple_reference_type;
+    //! The tuple of constant references to the arguments
+    typedef typename aux::event_tuple< typename add_reference< T const >::type... >::type tuple_const_reference_type;
+
+public:
+    //! Default constructor
+    event() {}
+    //! Constructor from the arguments
+    explicit event(arguments_type const& that) : arguments_type(that) {}
+    //! Constructor from the arguments, the arguments are moved
+    explicit event(arguments_type&& that) : arguments_type(static_cast< arguments_type&& >(that)) {}
+    //! Constructor from the argument values, the values are forwarded to the arguments constructors
+    template< typename... ArgsT >
+    explicit event(aux::event_args_init tag, ArgsT&&... args) : arguments_type(tag, static_cast< ArgsT&& >(args)...) {}
+    //! Constructor from a tuple
+    template< typename HeadT, typename TailT >
+    explicit event(tuples::cons< HeadT, TailT > const& that) : arguments_type(aux::event_tuple_init(), that) {}
+
+    //! Assignment, the argument is passed to the assignment of the tuple of references to the arguments
+    template< typename U >
+    event& operator= (U const& that)
+    {
+        get_tuple() = that;
+        return *this;
+    }
+
+    //! An accessor to the argument
+    template< std::size_t IndexV >
+    BOOST_FSM_FORCEINLINE typename aux::event_arg_access< typename aux::event_arg_at< IndexV, T... >::type >::reference get()
+    {
+        typedef typename aux::event_arg_at< IndexV, T... >::type arg_type;
+        typedef aux::event_field< IndexV, arg_type > field_type;
+        return aux::event_arg_access< arg_type >::unwrap(static_cast< field_type& >(*this).m_Value);
+    }
+    //! An accessor to the argument
+    template< std::size_t IndexV >
+    BOOST_FSM_FORCEINLINE typename aux::event_arg_access< typename aux::event_arg_at< IndexV, T... >::type >::const_reference get() const
+    {
+        typedef typename aux::event_arg_at< IndexV, T... >::type arg_type;
+        typedef aux::event_field< IndexV, arg_type > field_type;
+        return aux::event_arg_access< arg_type >::unwrap(static_cast< field_type const& >(*this).m_Value);
+    }
+
+    //! An accessor to the arguments
+    arguments_type& get_arguments() { return *this; }
+    //! An accessor to the arguments
+    arguments_type const& get_arguments() const { return *this; }
+
+    //! An accessor to the arguments as a tuple of references
+    tuple_reference_type get_tuple() { return this->template tie_fields< tuple_reference_type >(); }
+    //! An accessor to the arguments as a tuple of references
+    tuple_const_reference_type get_tuple() const { return this->template tie_fields< tuple_const_reference_type >(); }
+};
+
+//! Integral constant-tagged event type
+template< int TagV, typename... T >
+struct event_c :
+    public event< mpl::int_< TagV >, T... >
+{
+private:
+    //! Base type
+    typedef event< mpl::int_< TagV >, T... > base_type;
+
+public:
+    //! Tuple type import
+    typedef typename base_type::tuple_type tuple_type;
+    //! Arguments type import
+    typedef typename base_type::arguments_type arguments_type;
+
+public:
+    //! Default constructor
+    event_c() {}
+    //! Constructor from the arguments
+    explicit event_c(arguments_type const& that) : base_type(that) {}
+    //! Constructor from the arguments, the arguments are moved
+    explicit event_c(arguments_type&& that) : base_type(static_cast< arguments_type&& >(that)) {}
+    //! Constructor from the argument values, the values are forwarded to the arguments constructors
+    template< typename... ArgsT >
+    explicit event_c(aux::event_args_init tag, ArgsT&&... args) : base_type(tag, static_cast< ArgsT&& >(args)...) {}
+    //! Constructor from a tuple
+    template< typename HeadT, typename TailT >
+    explicit event_c(tuples::cons< HeadT, TailT > const& that) : base_type(that) {}
+
+    //! Assignment, the argument is passed to the assignment of the tuple of references to the arguments
+    template< typename U >
+    event_c& operator= (U const& that)
+    {
+        base_type::operator= (that);
+        return *this;
+    }
+};
+
+namespace aux {
+
+    //! An internal fsm::event type maker
+    template< typename TagT, typename... T >
+    struct event_type_maker
+    {
+        typedef event< TagT, typename event_arg_type< typename decay< T >::type >::type... > type;
+    };
+
+    //! An internal fsm::event type maker
+    template< int TagV, typename... T >
+    struct event_c_type_maker
+    {
+        typedef event_c< TagV, typename event_arg_type< typename decay< T >::type >::type... > type;
+    };
+
+    //! An internal metafunction that makes an fsm::event_c type with the same arguments and another tag
+    template< typename EventT, int TagV >
+    struct rebind_event_c;
+    template< int OldTagV, typename... T, int TagV >
+    struct rebind_event_c< event_c< OldTagV, T... >, TagV >
+    {
+        typedef event_c< TagV, T... > type;
+    };
+
+    //! The function allows to move the arguments into an event
+    template< typename ArgumentsT >
+    BOOST_FSM_FORCEINLINE ArgumentsT&& move_event_arguments(ArgumentsT& args)
+    {
+        return static_cast< ArgumentsT&& >(args);
+    }
+
+} // namespace aux
+
+/*!
+*    \brief The function makes an event from its arguments
+*
+*    The arguments are forwarded to the event arguments constructors, so the rvalue arguments are moved.
+*    The boost::reference_wrapper arguments are stored as references.
+*/
+template< typename TagT, typename... ArgsT >
+BOOST_FSM_FORCEINLINE typename aux::event_type_maker< TagT, ArgsT... >::type make_event(ArgsT&&... args)
+{
+    typedef typename aux::event_type_maker< TagT, ArgsT... >::type event_type;
+    return event_type(aux::event_args_init(), static_cast< ArgsT&& >(args)...);
+}
+//! The function makes an integral constant-tagged event from its arguments
+template< int TagV, typename... ArgsT >
+BOOST_FSM_FORCEINLINE typename aux::event_c_type_maker< TagV, ArgsT... >::type make_event(ArgsT&&... args)
+{
+    typedef typename aux::event_c_type_maker< TagV, ArgsT... >::type event_type;
+    return event_type(aux::event_args_init(), static_cast< ArgsT&& >(args)...);
+}
+
+#else // defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+
 namespace aux {
 
     /*!
@@ -78,6 +426,8 @@ struct event :
     typedef TagT tag_type;
     //! Tuple type
     typedef tuple< BOOST_PP_ENUM(BOOST_FSM_MAX_EVENT_ARGS, BOOST_FSM_TUPLE_ARG_TYPE, T) > tuple_type;
+    //! Arguments type
+    typedef tuple_type arguments_type;
 
     //! Default constructor
     event() {}
@@ -98,6 +448,21 @@ struct event :
         return *this;
     }
 
+    //! An accessor to the argument
+    template< int N >
+    BOOST_FSM_FORCEINLINE typename aux::event_arg_access< typename tuples::element< N, tuple_type >::type >::reference get()
+    {
+        typedef typename tuples::element< N, tuple_type >::type arg_type;
+        return aux::event_arg_access< arg_type >::unwrap(tuple_type::template get< N >());
+    }
+    //! An accessor to the argument
+    template< int N >
+    BOOST_FSM_FORCEINLINE typename aux::event_arg_access< typename tuples::element< N, tuple_type >::type >::const_reference get() const
+    {
+        typedef typename tuples::element< N, tuple_type >::type arg_type;
+        return aux::event_arg_access< arg_type >::unwrap(tuple_type::template get< N >());
+    }
+
     //! An accessor to tuple
     tuple_type& get_tuple() { return *this; }
     //! An accessor to tuple
@@ -118,6 +483,8 @@ private:
 public:
     //! Tuple type import
     typedef typename base_type::tuple_type tuple_type;
+    //! Arguments type import
+    typedef typename base_type::arguments_type arguments_type;
 
 public:
     //! Default constructor
@@ -142,20 +509,6 @@ public:
 
 namespace aux {
 
-    /*!
-    *    \brief An internal mapper that transforms reference_wrapper into a real reference type
-    *           to ease fsm::event usage in the on_process handlers and transition rules
-    */
-    template< typename T >
-    struct event_arg_type :
-        public mpl::if_<
-            is_reference_wrapper< T >,
-            add_reference< typename unwrap_reference< T >::type >,
-            mpl::identity< T >
-        >::type
-    {
-    };
-
 #define BOOST_FSM_EVENT_ARG_TYPE(z, iter, data)\
     typename event_arg_type< BOOST_PP_CAT(data, iter) >::type
 
@@ -175,6 +528,23 @@ namespace aux {
 
 #undef BOOST_FSM_EVENT_ARG_TYPE
 
+    //! An internal metafunction that makes an fsm::event_c type with the same arguments and another tag
+    template< typename EventT, int TagV >
+    struct rebind_event_c;
+
+    template< int OldTagV, BOOST_PP_ENUM_PARAMS(BOOST_FSM_MAX_EVENT_ARGS, typename T), int TagV >
+    struct rebind_event_c< event_c< OldTagV, BOOST_PP_ENUM_PARAMS(BOOST_FSM_MAX_EVENT_ARGS, T) >, TagV >
+    {
+        typedef event_c< TagV, BOOST_PP_ENUM_PARAMS(BOOST_FSM_MAX_EVENT_ARGS, T) > type;
+    };
+
+    //! The function passes the arguments to an event constructor, the arguments are copied
+    template< typename ArgumentsT >
+    BOOST_FSM_FORCEINLINE ArgumentsT const& move_event_arguments(ArgumentsT& args)
+    {
+        return args;
+    }
+
 } // namespace aux
 
 #define BOOST_FSM_MAKE_EVENT(z, iter, data)\
@@ -198,6 +568,19 @@ BOOST_PP_REPEAT(BOOST_FSM_MAX_EVENT_ARGS, BOOST_FSM_MAKE_EVENT, ~)
 
 #undef BOOST_FSM_MAKE_EVENT
 
+#endif // defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+
+/*!
+*    \brief The event that is passed to the unexpected events handler by process_c if the run-time tag is out of range
+*/
+struct invalid_event_tag
+{
+    //! The tag value
+    int tag;
+
+    explicit invalid_event_tag(int t) : tag(t) {}
+};
+
 } // namespace fsm
 
 } // namespace boost
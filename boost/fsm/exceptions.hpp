@@ -28,8 +28,11 @@
 #include <string>
 #include <sstream>
 #include <typeinfo>
+#include <boost/config.hpp>
 #include <boost/any.hpp>
 #include <boost/optional.hpp>
+#include <boost/type_index.hpp>
+#include <boost/type_index/ctti_type_index.hpp>
 
 // Some compilers don't have type_info in std namespace
 #if defined(__INTEL_COMPILER) && defined(_MSC_VER) && (_MSC_VER <= 1310)
@@ -47,6 +50,14 @@ namespace fsm {
 //! State identifiers type
 typedef unsigned int state_id_t;
 
+/*!
+*    \brief Type information type
+*
+*    The type is std::type_info unless RTTI is disabled. In the latter case the type information
+*    is generated at compile time by Boost.TypeIndex.
+*/
+typedef typeindex::type_info type_info_t;
+
 namespace aux {
 
 #ifdef __GNUC__
@@ -109,9 +120,28 @@ namespace aux {
     }
 
     //! The function constructs a string, describing the type which type info is passed as an argument
-    inline std::string construct_type_name(std::type_info const& info)
+    inline std::string construct_type_name(type_info_t const& info)
     {
+#ifndef BOOST_NO_RTTI
         return construct_type_name_impl(info);
+#else
+        // The compile-time type information already contains the undecorated type name
+        return typeindex::type_index(info).pretty_name();
+#endif // BOOST_NO_RTTI
+    }
+
+    //! The function constructs a string, describing the type, from the compile-time type information without demangling
+    template< typename T >
+    inline std::string construct_type_name()
+    {
+        return typeindex::ctti_type_index::type_id< T >().pretty_name();
+    }
+
+    //! The function returns type information of the type
+    template< typename T >
+    inline type_info_t const& type_info_of()
+    {
+        return typeindex::type_id< T >().type_info();
     }
 
 } // namespace aux
@@ -122,7 +152,7 @@ class BOOST_FSM_EXTERNALLY_VISIBLE fsm_error :
 {
 private:
     //! Type info of the state in which the state machine persisted when the error occurred
-    std::type_info const& m_StateType;
+    type_info_t const& m_StateType;
     //! Identifier of the state in which the state machine persisted when the error occurred
     state_id_t m_StateID;
     //! Name of the state in which the state machine persisted when the error occurred
@@ -132,12 +162,12 @@ private:
 
 public:
     //! Basic form of constructor
-    fsm_error(std::type_info const& StateType, state_id_t StateID)
+    fsm_error(type_info_t const& StateType, state_id_t StateID)
         : m_StateType(StateType), m_StateID(StateID)
     {
     }
     //! The constructor with state name provision
-    fsm_error(std::string const& StateName, std::type_info const& StateType, state_id_t StateID)
+    fsm_error(std::string const& StateName, type_info_t const& StateType, state_id_t StateID)
         : m_StateType(StateType), m_StateID(StateID), m_StateName(StateName)
     {
     }
@@ -145,7 +175,7 @@ public:
     ~fsm_error() throw() {}
 
     //! An accessor to type info of the state in which the state machine persisted when the error occurred
-    std::type_info const& current_state_type() const { return m_StateType; }
+    type_info_t const& current_state_type() const { return m_StateType; }
     //! An accessor to identifier of the state in which the state machine persisted when the error occurred
     state_id_t current_state_id() const { return m_StateID; }
 
@@ -154,14 +184,18 @@ public:
     {
         const char* pErrorInfo = "fsm_error";
 
+#ifndef BOOST_NO_EXCEPTIONS
         try
+#endif // BOOST_NO_EXCEPTIONS
         {
             if (!!m_ErrorInfo)
                 pErrorInfo = m_ErrorInfo->c_str();
         }
+#ifndef BOOST_NO_EXCEPTIONS
         catch (std::exception&)
         {
         }
+#endif // BOOST_NO_EXCEPTIONS
 
         return pErrorInfo;
     }
@@ -187,12 +221,12 @@ private:
 
 public:
     //! Basic version of constructor
-    bad_state_id(state_id_t BadStateID, std::type_info const& StateType, state_id_t StateID)
+    bad_state_id(state_id_t BadStateID, type_info_t const& StateType, state_id_t StateID)
         : fsm_error(StateType, StateID), m_BadStateID(BadStateID)
     {
     }
     //! A constructor with state name provision
-    bad_state_id(state_id_t BadStateID, std::string const& StateName, std::type_info const& StateType, state_id_t StateID)
+    bad_state_id(state_id_t BadStateID, std::string const& StateName, type_info_t const& StateType, state_id_t StateID)
         : fsm_error(StateName, StateType, StateID), m_BadStateID(BadStateID)
     {
     }
@@ -207,7 +241,9 @@ public:
     {
         const char* pErrorInfo = "bad_state_id: an attempt to use invalid state id detected";
 
+#ifndef BOOST_NO_EXCEPTIONS
         try
+#endif // BOOST_NO_EXCEPTIONS
         {
             if (!error_info())
             {
@@ -226,9 +262,11 @@ public:
             }
             pErrorInfo = error_info()->c_str();
         }
+#ifndef BOOST_NO_EXCEPTIONS
         catch (std::exception&)
         {
         }
+#endif // BOOST_NO_EXCEPTIONS
 
         return pErrorInfo;
     }
@@ -244,12 +282,12 @@ private:
 
 public:
     //! Basic version of constructor
-    unexpected_event(any const& Event, std::type_info const& StateType, state_id_t StateID)
+    unexpected_event(any const& Event, type_info_t const& StateType, state_id_t StateID)
         : fsm_error(StateType, StateID), m_Event(Event)
     {
     }
     //! A constructor with state name provision
-    unexpected_event(any const& Event, std::string const& StateName, std::type_info const& StateType, state_id_t StateID)
+    unexpected_event(any const& Event, std::string const& StateName, type_info_t const& StateType, state_id_t StateID)
         : fsm_error(StateName, StateType, StateID), m_Event(Event)
     {
     }
@@ -264,7 +302,9 @@ public:
     {
         const char* pErrorInfo = "unexpected_event: the state machine does not expect the event in the current state";
 
+#ifndef BOOST_NO_EXCEPTIONS
         try
+#endif // BOOST_NO_EXCEPTIONS
         {
             if (!error_info())
             {
@@ -283,9 +323,66 @@ public:
             }
             pErrorInfo = error_info()->c_str();
         }
+#ifndef BOOST_NO_EXCEPTIONS
+        catch (std::exception&)
+        {
+        }
+#endif // BOOST_NO_EXCEPTIONS
+
+        return pErrorInfo;
+    }
+};
+
+//! An exception class thrown by library in case of an error in a dynamic state machine definition
+class BOOST_FSM_EXTERNALLY_VISIBLE bad_machine_definition :
+    public std::exception
+{
+private:
+    //! The line of the definition where the error was found, 0 if the definition was not loaded from text
+    unsigned int m_Line;
+    //! Error description
+    std::string m_Description;
+    //! Error description with the line number. It only constructed when the exception is asked for.
+    mutable optional< std::string > m_ErrorInfo;
+
+public:
+    //! Constructor
+    explicit bad_machine_definition(std::string const& Description, unsigned int Line = 0)
+        : m_Line(Line), m_Description(Description)
+    {
+    }
+    //! Non-throwing destructor
+    ~bad_machine_definition() throw() {}
+
+    //! An accessor to the line of the definition where the error was found
+    unsigned int line() const { return m_Line; }
+
+    //! The method returns error description
+    const char* what() const throw()
+    {
+        const char* pErrorInfo = "bad_machine_definition: the state machine definition is not valid";
+
+#ifndef BOOST_NO_EXCEPTIONS
+        try
+#endif // BOOST_NO_EXCEPTIONS
+        {
+            if (!m_ErrorInfo)
+            {
+                // Construct error description string
+                std::ostringstream strm;
+                strm << "bad_machine_definition: " << m_Description;
+                if (m_Line != 0)
+                    strm << " at line " << m_Line;
+
+                m_ErrorInfo = strm.str();
+            }
+            pErrorInfo = m_ErrorInfo->c_str();
+        }
+#ifndef BOOST_NO_EXCEPTIONS
         catch (std::exception&)
         {
         }
+#endif // BOOST_NO_EXCEPTIONS
 
         return pErrorInfo;
     }
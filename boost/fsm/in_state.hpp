@@ -0,0 +1,129 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \file   in_state.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ *
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         typed handles of state machines in a known state are implemented.
+ */
+
+#if (defined(_MSC_VER) && _MSC_VER > 1020)
+#pragma once
+#endif // _MSC_VER > 1020
+
+#ifndef BOOST_FSM_IN_STATE_HPP_INCLUDED_
+#define BOOST_FSM_IN_STATE_HPP_INCLUDED_
+
+#include <boost/assert.hpp>
+#include <boost/fsm/state_machine.hpp>
+
+namespace boost {
+
+namespace fsm {
+
+/*!
+*    \brief A handle of the state machine that is known to be in the StateT state
+*
+*    The handle delivers events to the StateT state without the table dispatch. Since event handlers
+*    may change the current state, the handle checks the current state on each call and falls back
+*    to the table dispatch if the state machine has left StateT.
+*/
+template< typename StateT, typename StateMachineT >
+class in_state
+{
+public:
+    //! State type
+    typedef StateT state_type;
+    //! State machine type
+    typedef StateMachineT state_machine_type;
+    //! State machine return type
+    typedef typename state_machine_type::return_type return_type;
+
+private:
+    //! A reference to the state machine
+    state_machine_type& m_Machine;
+
+public:
+    /*!
+    *    \brief Constructor
+    *    \param machine The state machine which is in the StateT state
+    *    \throw None
+    */
+    explicit in_state(state_machine_type& machine) : m_Machine(machine)
+    {
+        BOOST_ASSERT(machine.BOOST_NESTED_TEMPLATE is_in_state< state_type >());
+    }
+
+    /*!
+    *    \brief Event processing routine
+    *    \sa state_machine::process_in_state
+    */
+    template< typename EventT >
+    return_type process(EventT const& evt) const
+    {
+        return m_Machine.BOOST_NESTED_TEMPLATE process_in_state< state_type >(evt);
+    }
+
+    /*!
+    *    \brief The method checks if the state machine is still in the StateT state
+    *    \throw None
+    */
+    bool is_valid() const
+    {
+        return m_Machine.BOOST_NESTED_TEMPLATE is_in_state< state_type >();
+    }
+
+    /*!
+    *    \brief An accessor to the state
+    *    \throw None
+    */
+    state_type& get_state() const
+    {
+        return m_Machine.BOOST_NESTED_TEMPLATE get< state_type >();
+    }
+
+    /*!
+    *    \brief An accessor to the state machine
+    *    \throw None
+    */
+    state_machine_type& get_state_machine() const
+    {
+        return m_Machine;
+    }
+
+private:
+    //! The class is not assignable
+    in_state& operator= (in_state const&);
+};
+
+/*!
+*    \brief The function calls a function object with a handle of the state machine if it is in the StateT state
+*    \param machine The state machine
+*    \param fun The function object, is called with in_state< StateT, StateMachineT > const& argument
+*    \return true if the state machine is in the StateT state and the function object has been called, false otherwise
+*    \throw Nothing unless the function object throws
+*/
+template< typename StateT, typename StateMachineT, typename FunT >
+inline bool with_state(StateMachineT& machine, FunT fun)
+{
+    if (machine.BOOST_NESTED_TEMPLATE is_in_state< StateT >())
+    {
+        in_state< StateT, StateMachineT > const handle(machine);
+        fun(handle);
+        return true;
+    }
+    else
+        return false;
+}
+
+} // namespace fsm
+
+} // namespace boost
+
+#endif // BOOST_FSM_IN_STATE_HPP_INCLUDED_
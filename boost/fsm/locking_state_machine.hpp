@@ -25,6 +25,9 @@
 #include <boost/aligned_storage.hpp>
 #include <boost/utility/addressof.hpp>
 #include <boost/detail/lightweight_mutex.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+#include <boost/preprocessor/repetition/enum_trailing_params.hpp>
+#include <boost/preprocessor/repetition/enum_trailing_binary_params.hpp>
 #include <boost/fsm/state_machine.hpp>
 
 namespace boost {
@@ -78,14 +81,15 @@ template<
     typename RetValT = void,
     typename TransitionListT = void,
     typename MutexT = detail::lightweight_mutex,
-    typename LockerT = typename MutexT::scoped_lock
+    typename LockerT = typename MutexT::scoped_lock,
+    typename UnexpectedHandlerT = void
 >
 class locking_state_machine :
-    public aux::basic_state_machine< StateListT, RetValT, TransitionListT >
+    public aux::basic_state_machine< StateListT, RetValT, TransitionListT, UnexpectedHandlerT >
 {
 private:
     //! Base type
-    typedef aux::basic_state_machine< StateListT, RetValT, TransitionListT > base_type;
+    typedef aux::basic_state_machine< StateListT, RetValT, TransitionListT, UnexpectedHandlerT > base_type;
 
 protected:
     //! Root type
@@ -131,7 +135,8 @@ public:
         RetValT,
         TransitionListT,
         AnotherMutexT,
-        AnotherLockerT
+        AnotherLockerT,
+        UnexpectedHandlerT
     > const& that)
         // We use here comma operator trick to lock the argument right before the copying begins
         : base_type((typename locking_state_machine<
@@ -139,7 +144,8 @@ public:
             RetValT,
             TransitionListT,
             AnotherMutexT,
-            AnotherLockerT
+            AnotherLockerT,
+            UnexpectedHandlerT
         >::scoped_lock(that.get_mutex()), static_cast< base_type const& >(that))), m_Mutex()
     {
     }
@@ -184,7 +190,8 @@ public:
         RetValT,
         TransitionListT,
         AnotherMutexT,
-        AnotherLockerT
+        AnotherLockerT,
+        UnexpectedHandlerT
     > const& that)
     {
         // Define types of that state machine and its locker
@@ -193,7 +200,8 @@ public:
             RetValT,
             TransitionListT,
             AnotherMutexT,
-            AnotherLockerT
+            AnotherLockerT,
+            UnexpectedHandlerT
         > that_type;
         typedef typename that_type::scoped_lock that_scoped_lock;
 
@@ -230,6 +238,77 @@ public:
         scoped_lock lock(m_Mutex);
         return base_type::process(evt);
     }
+    /*!
+    *    \brief Event processing routine (non-throwing version)
+    *    \sa state_machine::try_process
+    */
+    template< typename EventT >
+    result< return_type > try_process(EventT const& evt)
+    {
+        scoped_lock lock(m_Mutex);
+        return base_type::try_process(evt);
+    }
+    /*!
+    *    \brief Event processing routine for events passed by a reference to their base class
+    *    \sa state_machine::process_dynamic
+    */
+    template< typename EventListT, typename EventBaseT >
+    return_type process_dynamic(EventBaseT const& evt)
+    {
+        scoped_lock lock(m_Mutex);
+        return base_type::BOOST_NESTED_TEMPLATE process_dynamic< EventListT >(evt);
+    }
+    /*!
+    *    \brief Event processing routine for events passed by a reference to their base class
+    *    \sa state_machine::process_dynamic
+    */
+    template< typename EventListT, typename EventBaseT >
+    return_type process_dynamic(EventBaseT const& evt, std::size_t index)
+    {
+        scoped_lock lock(m_Mutex);
+        return base_type::BOOST_NESTED_TEMPLATE process_dynamic< EventListT >(evt, index);
+    }
+
+#if defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+    /*!
+    *    \brief Event processing routine for integral constant-tagged events with the tag known in run time
+    *    \sa state_machine::process_c
+    */
+    template< int BeginTagV, int EndTagV, typename... ArgsT >
+    return_type process_c(int tag, ArgsT&&... args)
+    {
+        scoped_lock lock(m_Mutex);
+        return base_type::BOOST_NESTED_TEMPLATE process_c< BeginTagV, EndTagV >(tag, static_cast< ArgsT&& >(args)...);
+    }
+#else // defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+
+#define BOOST_FSM_PROCESS_C(z, iter, data)\
+    template< int BeginTagV, int EndTagV BOOST_PP_ENUM_TRAILING_PARAMS(iter, typename T) >\
+    return_type process_c(int tag BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(iter, T, const& Arg))\
+    {\
+        scoped_lock lock(m_Mutex);\
+        return base_type::BOOST_NESTED_TEMPLATE process_c< BeginTagV, EndTagV >(tag BOOST_PP_ENUM_TRAILING_PARAMS(iter, Arg));\
+    }
+
+    /*!
+    *    \brief Event processing routine for integral constant-tagged events with the tag known in run time
+    *    \sa state_machine::process_c
+    */
+    BOOST_PP_REPEAT(BOOST_FSM_MAX_EVENT_ARGS, BOOST_FSM_PROCESS_C, ~)
+
+#undef BOOST_FSM_PROCESS_C
+
+#endif // defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+    /*!
+    *    \brief Event processing routine for the case when the current state is likely known
+    *    \sa state_machine::process_in_state
+    */
+    template< typename StateT, typename EventT >
+    return_type process_in_state(EventT const& evt)
+    {
+        scoped_lock lock(m_Mutex);
+        return base_type::BOOST_NESTED_TEMPLATE process_in_state< StateT >(evt);
+    }
 
     /*!
     *    \brief The method resets the state machine to its initial state
@@ -243,7 +322,7 @@ public:
 
     /*!
     *    \brief The method sets an unexpected events handler
-    *    \sa state_machine_root::set_unexpected_event_handler
+    *    \sa aux::unexpected_event_handler_storage::set_unexpected_event_handler
     */
     template< typename T >
     void set_unexpected_event_handler(T const& handler)
@@ -253,7 +332,7 @@ public:
     }
     /*!
     *    \brief The method resets the unexpected events handler to the default
-    *    \sa state_machine_root::set_default_unexpected_event_handler
+    *    \sa aux::unexpected_event_handler_storage::set_default_unexpected_event_handler
     */
     void set_default_unexpected_event_handler()
     {
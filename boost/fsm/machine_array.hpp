@@ -0,0 +1,276 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \file   machine_array.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ *
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         the array of table state machines that are processed in lock-step is implemented.
+ */
+
+#if (defined(_MSC_VER) && _MSC_VER > 1020)
+#pragma once
+#endif // _MSC_VER > 1020
+
+#ifndef BOOST_FSM_MACHINE_ARRAY_HPP_INCLUDED_
+#define BOOST_FSM_MACHINE_ARRAY_HPP_INCLUDED_
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/contains.hpp>
+#include <boost/mpl/index_of.hpp>
+#include <boost/fsm/table_state_machine.hpp>
+
+// Vectorized event processing support. Define BOOST_FSM_NO_SIMD to always use the scalar code.
+#if !defined(BOOST_FSM_NO_SIMD)
+#if defined(__AVX2__)
+#define BOOST_FSM_HAS_AVX2
+#endif // defined(__AVX2__)
+#if defined(__SSSE3__) || defined(__AVX__)
+#define BOOST_FSM_HAS_SSSE3
+#endif // defined(__SSSE3__) || defined(__AVX__)
+#endif // !defined(BOOST_FSM_NO_SIMD)
+
+#if defined(BOOST_FSM_HAS_AVX2)
+#include <immintrin.h>
+#elif defined(BOOST_FSM_HAS_SSSE3)
+#include <tmmintrin.h>
+#endif
+
+namespace boost {
+
+namespace fsm {
+
+namespace aux {
+
+    /*!
+    *    \brief The transposed transition table
+    *
+    *    The table holds the next states for every event in a contiguous column, so that a single event
+    *    may be applied to many states with lookups in the column. The columns are padded, so that
+    *    the vectorized code is able to load a whole column or read a few bytes past the last state.
+    */
+    template< typename TableT >
+    class transition_columns
+    {
+    public:
+        //! State index type
+        typedef typename TableT::state_index_type state_index_type;
+
+        //! Number of states
+        BOOST_STATIC_CONSTANT(unsigned int, states_count = TableT::states_count);
+        //! Number of events
+        BOOST_STATIC_CONSTANT(unsigned int, events_count = TableT::events_count);
+        //! Column size
+        BOOST_STATIC_CONSTANT(unsigned int, column_size = states_count + 16u);
+
+    private:
+        //! The next states
+        state_index_type m_Columns[events_count][column_size];
+
+        //! The only table instance
+        static transition_columns const g_Instance;
+
+    public:
+        //! Default constructor
+        BOOST_FSM_NOINLINE transition_columns()
+        {
+            // The order of initialization of the static tables is not specified, so a separate copy of the table is built
+            scoped_ptr< TableT const > pTable(new TableT());
+            TableT const& table = *pTable;
+            for (unsigned int e = 0; e < events_count; ++e)
+            {
+                for (unsigned int s = 0; s < states_count; ++s)
+                    m_Columns[e][s] = table.next_state(static_cast< state_index_type >(s), e);
+                for (unsigned int s = states_count; s < column_size; ++s)
+                    m_Columns[e][s] = 0;
+            }
+        }
+
+        //! The subscript operator returns the column of the next states for the event
+        BOOST_FSM_FORCEINLINE state_index_type const* operator[] (std::size_t event_index) const
+        {
+            return m_Columns[event_index];
+        }
+
+        //! The method returns a reference to the only table instance
+        static BOOST_FSM_FORCEINLINE transition_columns const& get()
+        {
+            return g_Instance;
+        }
+    };
+
+    //! Implementation of the transposed transition tables
+    template< typename TableT >
+    transition_columns< TableT > const transition_columns< TableT >::g_Instance;
+
+    //! The function replaces every state with the next state from the column
+    template< typename StateIndexT >
+    inline void apply_column(StateIndexT* pStates, std::size_t n, StateIndexT const* pColumn, unsigned int)
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const StateIndexT s0 = pColumn[pStates[i]], s1 = pColumn[pStates[i + 1]];
+            const StateIndexT s2 = pColumn[pStates[i + 2]], s3 = pColumn[pStates[i + 3]];
+            pStates[i] = s0;
+            pStates[i + 1] = s1;
+            pStates[i + 2] = s2;
+            pStates[i + 3] = s3;
+        }
+        for (; i < n; ++i)
+            pStates[i] = pColumn[pStates[i]];
+    }
+
+#if defined(BOOST_FSM_HAS_SSSE3)
+
+    //! The function replaces every state with the next state from the column, the vectorized version for byte-sized states
+    inline void apply_column(uint8_t* pStates, std::size_t n, uint8_t const* pColumn, unsigned int states_count)
+    {
+        std::size_t i = 0;
+        if (states_count <= 16u)
+        {
+            // The whole column fits in a register, 16 states are looked up with a single shuffle
+            const __m128i column = _mm_loadu_si128(reinterpret_cast< const __m128i* >(pColumn));
+            for (; i + 16 <= n; i += 16)
+            {
+                __m128i states = _mm_loadu_si128(reinterpret_cast< const __m128i* >(pStates + i));
+                states = _mm_shuffle_epi8(column, states);
+                _mm_storeu_si128(reinterpret_cast< __m128i* >(pStates + i), states);
+            }
+        }
+#if defined(BOOST_FSM_HAS_AVX2)
+        else
+        {
+            // Gather 4 bytes at every state index and keep the lowest byte. The column is padded, so the loads do not overrun it.
+            const __m256i pack = _mm256_setr_epi8(
+                0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m256i merge = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+            for (; i + 8 <= n; i += 8)
+            {
+                const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast< const __m128i* >(pStates + i)));
+                __m256i states = _mm256_i32gather_epi32(reinterpret_cast< const int* >(pColumn), indices, 1);
+                states = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(states, pack), merge);
+                _mm_storel_epi64(reinterpret_cast< __m128i* >(pStates + i), _mm256_castsi256_si128(states));
+            }
+        }
+#endif // defined(BOOST_FSM_HAS_AVX2)
+
+        for (; i < n; ++i)
+            pStates[i] = pColumn[pStates[i]];
+    }
+
+#endif // defined(BOOST_FSM_HAS_SSSE3)
+
+} // namespace aux
+
+/*!
+*    \brief An array of table state machines of the same type
+*
+*    The array stores only the current state indices of the machines, in a contiguous array. An event may be
+*    passed to all machines at once, in which case the next states are looked up in the column of the transition
+*    table that corresponds to the event. If the states fit in a byte, the lookups are vectorized: with SSSE3,
+*    machines with up to 16 states are processed 16 at a time with byte shuffles, and with AVX2, larger machines are
+*    processed 8 at a time with gathers. Otherwise, or if BOOST_FSM_NO_SIMD is defined, the scalar code is used.
+*/
+template< typename TableStateMachineT >
+class machine_array
+{
+public:
+    //! Machine type
+    typedef TableStateMachineT machine_type;
+    //! States type sequence
+    typedef typename machine_type::states_type_list states_type_list;
+    //! Events type sequence
+    typedef typename machine_type::events_type_list events_type_list;
+    //! Transition table type
+    typedef typename machine_type::table_type table_type;
+    //! State index type
+    typedef typename machine_type::state_index_type state_index_type;
+    //! Size type
+    typedef std::size_t size_type;
+
+private:
+    //! Transposed transition table type
+    typedef aux::transition_columns< table_type > columns_type;
+
+private:
+    //! The current states of the machines
+    std::vector< state_index_type > m_States;
+
+public:
+    //! Constructor, the machines are in the initial state
+    explicit machine_array(size_type n = 0) : m_States(n, static_cast< state_index_type >(0)) {}
+
+    //! The method returns the number of machines
+    size_type size() const { return m_States.size(); }
+    //! The method changes the number of machines, the added machines are in the initial state
+    void resize(size_type n) { m_States.resize(n, static_cast< state_index_type >(0)); }
+    //! The method resets all machines to the initial state
+    void reset() { std::fill(m_States.begin(), m_States.end(), static_cast< state_index_type >(0)); }
+
+    //! The method passes the event to all machines
+    template< typename EventT >
+    void process(EventT const&)
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< events_type_list, EventT >::value));
+        process_index(mpl::index_of< events_type_list, EventT >::type::value);
+    }
+    //! The method passes the event with the specified index in the events list to all machines
+    void process_index(std::size_t event_index)
+    {
+        BOOST_ASSERT(event_index < machine_type::events_count);
+        if (!m_States.empty())
+        {
+            aux::apply_column(&m_States[0], m_States.size(), columns_type::get()[event_index], machine_type::states_count);
+        }
+    }
+
+    /*!
+    *    \brief The method passes the event to a single machine
+    *    \return The action identifier of the transition, 0 if the transition has no action or no rule applies
+    */
+    template< typename EventT >
+    unsigned int process(size_type index, EventT const&)
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< events_type_list, EventT >::value));
+        BOOST_ASSERT(index < m_States.size());
+        const std::size_t event_index = mpl::index_of< events_type_list, EventT >::type::value;
+        table_type const& table = table_type::get();
+        state_index_type& state = m_States[index];
+        const unsigned int action = table.action(state, event_index);
+        state = table.next_state(state, event_index);
+        return action;
+    }
+
+    //! The method returns the current state identifier of the machine, see table_state_machine
+    state_id_t get_current_state_id(size_type index) const
+    {
+        BOOST_ASSERT(index < m_States.size());
+        return table_type::get().state_id(m_States[index]);
+    }
+    //! The method checks if the machine is in the specified state, see table_state_machine
+    template< typename StateT >
+    bool is_in_state(size_type index) const
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< states_type_list, StateT >::value));
+        BOOST_ASSERT(index < m_States.size());
+        return (m_States[index] == table_type::get().state_class(mpl::index_of< states_type_list, StateT >::type::value));
+    }
+};
+
+} // namespace fsm
+
+} // namespace boost
+
+#endif // BOOST_FSM_MACHINE_ARRAY_HPP_INCLUDED_
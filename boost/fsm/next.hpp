@@ -0,0 +1,112 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \file   next.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ *
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         the result type of event handlers that name the next state is implemented.
+ */
+
+#if (defined(_MSC_VER) && _MSC_VER > 1020)
+#pragma once
+#endif // _MSC_VER > 1020
+
+#ifndef BOOST_FSM_NEXT_HPP_INCLUDED_
+#define BOOST_FSM_NEXT_HPP_INCLUDED_
+
+#include <boost/static_assert.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/mpl/contains.hpp>
+#include <boost/mpl/index_of.hpp>
+#include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/preprocessor/repetition/enum_binary_params.hpp>
+#include <boost/preprocessor/facilities/intercept.hpp>
+#include <boost/fsm/detail/prologue.hpp>
+
+#ifndef BOOST_FSM_MAX_NEXT_STATES
+//! The maximum number of target states of the next class template
+#define BOOST_FSM_MAX_NEXT_STATES 5
+#endif // BOOST_FSM_MAX_NEXT_STATES
+
+namespace boost {
+
+namespace fsm {
+
+namespace aux {
+
+    //! A common base for the next class template specializations
+    class next_base
+    {
+    protected:
+        //! Index of the target state in the list of the possible targets, the list size means no transition
+        unsigned int m_Index;
+
+    protected:
+        //! Constructor
+        explicit next_base(unsigned int index) : m_Index(index) {}
+
+    public:
+        //! The method returns the index of the target state in the list of the possible targets
+        unsigned int index() const { return m_Index; }
+    };
+
+} // namespace aux
+
+/*!
+*    \brief The result of an event handler that names the next state
+*
+*    An on_process handler may return an object of this type instead of calling switch_to. The possible
+*    target states are listed in the template parameters, and the object selects one of them or no transition at all.
+*    The state machine performs the transition after the handler returns. Since all the targets are known at compile
+*    time, the transition does not involve the state dispatching table. The handlers of this kind may only be used
+*    in state machines with void return type.
+*/
+template< BOOST_PP_ENUM_BINARY_PARAMS(BOOST_FSM_MAX_NEXT_STATES, typename StateT, = mpl::na BOOST_PP_INTERCEPT) >
+class next :
+    public aux::next_base
+{
+public:
+    //! The list of possible target states
+    typedef typename mpl::vector< BOOST_PP_ENUM_PARAMS(BOOST_FSM_MAX_NEXT_STATES, StateT) >::type states_type_list;
+
+private:
+    //! Constructor
+    explicit next(unsigned int index) : aux::next_base(index) {}
+
+public:
+    /*!
+    *    \brief Constructor, selects the only target state
+    *
+    *    The constructor may only be used if there is a single target state.
+    */
+    next() : aux::next_base(0)
+    {
+        BOOST_STATIC_ASSERT(mpl::size< states_type_list >::value == 1);
+    }
+
+    //! The method returns an object that selects the target state
+    template< typename TargetStateT >
+    static next to()
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< states_type_list, TargetStateT >::value));
+        return next(mpl::index_of< states_type_list, TargetStateT >::type::value);
+    }
+    //! The method returns an object that selects no transition
+    static next stay()
+    {
+        return next(mpl::size< states_type_list >::value);
+    }
+};
+
+} // namespace fsm
+
+} // namespace boost
+
+#endif // BOOST_FSM_NEXT_HPP_INCLUDED_
@@ -0,0 +1,312 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \file   packed_machine_array.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ *
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         the bit-packed array of table state machines with up to four states is implemented.
+ */
+
+#if (defined(_MSC_VER) && _MSC_VER > 1020)
+#pragma once
+#endif // _MSC_VER > 1020
+
+#ifndef BOOST_FSM_PACKED_MACHINE_ARRAY_HPP_INCLUDED_
+#define BOOST_FSM_PACKED_MACHINE_ARRAY_HPP_INCLUDED_
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/contains.hpp>
+#include <boost/mpl/index_of.hpp>
+#include <boost/fsm/table_state_machine.hpp>
+
+namespace boost {
+
+namespace fsm {
+
+namespace aux {
+
+    //! The function returns the number of set bits in the word
+    inline unsigned int popcount(uint64_t word)
+    {
+#if defined(__GNUC__)
+        return static_cast< unsigned int >(__builtin_popcountll(word));
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast< unsigned int >((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    /*!
+    *    \brief Bitwise operations on the machines packed into words, one bit per machine
+    *
+    *    An event maps the state of every machine with a function from {0, 1} to {0, 1}, which is applied
+    *    to all machines in a word with the masks that select the next state for each of the current states.
+    */
+    template< unsigned int BitsV >
+    struct packed_states
+    {
+        //! The masks of the state transition function of an event
+        struct transition_masks
+        {
+            //! The next state bit of all machines, for the current state 0 and 1
+            uint64_t m_Next[2];
+        };
+
+        //! The number of machines in a word
+        BOOST_STATIC_CONSTANT(unsigned int, machines_per_word = 64u);
+
+        //! The function builds the masks from the next states for every current state
+        static void make_masks(transition_masks& masks, unsigned int const* next_states, unsigned int states_count)
+        {
+            for (unsigned int v = 0; v < 2; ++v)
+            {
+                const unsigned int next = v < states_count ? next_states[v] : v;
+                masks.m_Next[v] = (next & 1u) ? ~uint64_t(0) : uint64_t(0);
+            }
+        }
+
+        //! The function applies the transition to all machines in the word
+        static BOOST_FSM_FORCEINLINE uint64_t apply(uint64_t word, transition_masks const& masks)
+        {
+            return (~word & masks.m_Next[0]) | (word & masks.m_Next[1]);
+        }
+
+        //! The function returns the mask of the machines in the state
+        static BOOST_FSM_FORCEINLINE uint64_t select(uint64_t word, unsigned int state)
+        {
+            return state ? word : ~word;
+        }
+    };
+
+    /*!
+    *    \brief Bitwise operations on the machines packed into words, two bits per machine
+    *
+    *    The low and high bits of the states are processed separately. For every current state a mask of the machines
+    *    in that state is built, and the bits of the next states are combined from these masks.
+    */
+    template< >
+    struct packed_states< 2u >
+    {
+        //! The masks of the state transition function of an event
+        struct transition_masks
+        {
+            //! The low bit of the next state of all machines, for every current state
+            uint64_t m_Low[4];
+            //! The high bit of the next state of all machines, for every current state
+            uint64_t m_High[4];
+        };
+
+        //! The number of machines in a word
+        BOOST_STATIC_CONSTANT(unsigned int, machines_per_word = 32u);
+
+        //! The function builds the masks from the next states for every current state
+        static void make_masks(transition_masks& masks, unsigned int const* next_states, unsigned int states_count)
+        {
+            for (unsigned int v = 0; v < 4; ++v)
+            {
+                const unsigned int next = v < states_count ? next_states[v] : v;
+                masks.m_Low[v] = (next & 1u) ? 0x5555555555555555ULL : uint64_t(0);
+                masks.m_High[v] = (next & 2u) ? 0xAAAAAAAAAAAAAAAAULL : uint64_t(0);
+            }
+        }
+
+        //! The function applies the transition to all machines in the word
+        static BOOST_FSM_FORCEINLINE uint64_t apply(uint64_t word, transition_masks const& masks)
+        {
+            const uint64_t low = word & 0x5555555555555555ULL, not_low = ~word & 0x5555555555555555ULL;
+            const uint64_t high = (word >> 1) & 0x5555555555555555ULL, not_high = (~word >> 1) & 0x5555555555555555ULL;
+            const uint64_t in0 = not_high & not_low, in1 = not_high & low, in2 = high & not_low, in3 = high & low;
+            const uint64_t in0x2 = in0 | (in0 << 1), in1x2 = in1 | (in1 << 1), in2x2 = in2 | (in2 << 1), in3x2 = in3 | (in3 << 1);
+
+            return (in0x2 & (masks.m_Low[0] | masks.m_High[0]))
+                | (in1x2 & (masks.m_Low[1] | masks.m_High[1]))
+                | (in2x2 & (masks.m_Low[2] | masks.m_High[2]))
+                | (in3x2 & (masks.m_Low[3] | masks.m_High[3]));
+        }
+
+        //! The function returns the mask of the machines in the state, one bit per machine at the low bit of the machine
+        static BOOST_FSM_FORCEINLINE uint64_t select(uint64_t word, unsigned int state)
+        {
+            const uint64_t low = (state & 1u) ? word : ~word;
+            const uint64_t high = (state & 2u) ? (word >> 1) : ~(word >> 1);
+            return low & high & 0x5555555555555555ULL;
+        }
+    };
+
+} // namespace aux
+
+/*!
+*    \brief A bit-packed array of table state machines with up to four states
+*
+*    The array stores the current states of the machines as one bit per machine if there are up to two states,
+*    or two bits per machine if there are up to four states. The bulk event processing applies the transition
+*    table column of the event to whole 64-bit words with bitwise operations.
+*/
+template< typename TableStateMachineT >
+class packed_machine_array
+{
+public:
+    //! Machine type
+    typedef TableStateMachineT machine_type;
+    //! States type sequence
+    typedef typename machine_type::states_type_list states_type_list;
+    //! Events type sequence
+    typedef typename machine_type::events_type_list events_type_list;
+    //! Transition table type
+    typedef typename machine_type::table_type table_type;
+    //! Size type
+    typedef std::size_t size_type;
+
+    BOOST_STATIC_ASSERT(machine_type::states_count <= 4u);
+
+    //! The number of bits per machine
+    BOOST_STATIC_CONSTANT(unsigned int, bits_per_machine = (machine_type::states_count <= 2u ? 1u : 2u));
+
+private:
+    //! Bitwise operations implementation
+    typedef aux::packed_states< bits_per_machine > packed_states_type;
+
+public:
+    //! The number of machines in a word
+    BOOST_STATIC_CONSTANT(unsigned int, machines_per_word = packed_states_type::machines_per_word);
+
+private:
+    //! The packed states of the machines
+    std::vector< uint64_t > m_Words;
+    //! The number of machines
+    size_type m_Size;
+
+public:
+    //! Constructor, the machines are in the initial state
+    explicit packed_machine_array(size_type n = 0) :
+        m_Words((n + machines_per_word - 1) / machines_per_word, uint64_t(0)),
+        m_Size(n)
+    {
+    }
+
+    //! The method returns the number of machines
+    size_type size() const { return m_Size; }
+    //! The method changes the number of machines, the added machines are in the initial state
+    void resize(size_type n)
+    {
+        if (n > m_Size && (m_Size % machines_per_word) != 0)
+        {
+            // The unused bits of the last word may have been changed by the bulk processing
+            const unsigned int used_bits = static_cast< unsigned int >(m_Size % machines_per_word) * bits_per_machine;
+            m_Words.back() &= (uint64_t(1) << used_bits) - 1u;
+        }
+        m_Words.resize((n + machines_per_word - 1) / machines_per_word, uint64_t(0));
+        m_Size = n;
+    }
+    //! The method resets all machines to the initial state
+    void reset() { std::fill(m_Words.begin(), m_Words.end(), uint64_t(0)); }
+
+    //! The method passes the event to all machines
+    template< typename EventT >
+    void process(EventT const&)
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< events_type_list, EventT >::value));
+        process_index(mpl::index_of< events_type_list, EventT >::type::value);
+    }
+    //! The method passes the event with the specified index in the events list to all machines
+    void process_index(std::size_t event_index)
+    {
+        BOOST_ASSERT(event_index < machine_type::events_count);
+        table_type const& table = table_type::get();
+        unsigned int next_states[machine_type::states_count];
+        for (unsigned int s = 0; s < machine_type::states_count; ++s)
+            next_states[s] = table.next_state(static_cast< typename table_type::state_index_type >(s), event_index);
+
+        typename packed_states_type::transition_masks masks;
+        packed_states_type::make_masks(masks, next_states, machine_type::states_count);
+
+        for (std::vector< uint64_t >::iterator it = m_Words.begin(), end = m_Words.end(); it != end; ++it)
+            *it = packed_states_type::apply(*it, masks);
+    }
+
+    /*!
+    *    \brief The method passes the event to a single machine
+    *    \return The action identifier of the transition, 0 if the transition has no action or no rule applies
+    */
+    template< typename EventT >
+    unsigned int process(size_type index, EventT const&)
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< events_type_list, EventT >::value));
+        const std::size_t event_index = mpl::index_of< events_type_list, EventT >::type::value;
+        table_type const& table = table_type::get();
+        const typename table_type::state_index_type state = get_state(index);
+        const unsigned int action = table.action(state, event_index);
+        set_state(index, table.next_state(state, event_index));
+        return action;
+    }
+
+    //! The method returns the current state identifier of the machine, see table_state_machine
+    state_id_t get_current_state_id(size_type index) const
+    {
+        return table_type::get().state_id(get_state(index));
+    }
+    //! The method checks if the machine is in the specified state, see table_state_machine
+    template< typename StateT >
+    bool is_in_state(size_type index) const
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< states_type_list, StateT >::value));
+        return (get_state(index) == table_type::get().state_class(mpl::index_of< states_type_list, StateT >::type::value));
+    }
+    //! The method returns the number of machines in the specified state
+    template< typename StateT >
+    size_type count_in_state() const
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< states_type_list, StateT >::value));
+        if (m_Words.empty())
+            return 0;
+
+        const unsigned int state = table_type::get().state_class(mpl::index_of< states_type_list, StateT >::type::value);
+        size_type count = 0;
+        const std::size_t last = m_Words.size() - 1;
+        for (std::size_t i = 0; i < last; ++i)
+            count += aux::popcount(packed_states_type::select(m_Words[i], state));
+
+        uint64_t tail = packed_states_type::select(m_Words[last], state);
+        const unsigned int used_bits = static_cast< unsigned int >(m_Size - last * machines_per_word) * bits_per_machine;
+        if (used_bits < 64u)
+            tail &= (uint64_t(1) << used_bits) - 1u;
+        return count + aux::popcount(tail);
+    }
+
+private:
+    //! The method returns the state of the machine
+    typename table_type::state_index_type get_state(size_type index) const
+    {
+        BOOST_ASSERT(index < m_Size);
+        const unsigned int shift = static_cast< unsigned int >(index % machines_per_word) * bits_per_machine;
+        return static_cast< typename table_type::state_index_type >(
+            (m_Words[index / machines_per_word] >> shift) & ((1u << bits_per_machine) - 1u));
+    }
+    //! The method sets the state of the machine
+    void set_state(size_type index, unsigned int state)
+    {
+        BOOST_ASSERT(index < m_Size);
+        const unsigned int shift = static_cast< unsigned int >(index % machines_per_word) * bits_per_machine;
+        uint64_t& word = m_Words[index / machines_per_word];
+        word = (word & ~(uint64_t((1u << bits_per_machine) - 1u) << shift)) | (uint64_t(state) << shift);
+    }
+};
+
+} // namespace fsm
+
+} // namespace boost
+
+#endif // BOOST_FSM_PACKED_MACHINE_ARRAY_HPP_INCLUDED_
@@ -0,0 +1,210 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \file   reachability.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ *
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         the compile-time analysis of the states reachability is implemented.
+ */
+
+#if (defined(_MSC_VER) && _MSC_VER > 1020)
+#pragma once
+#endif // _MSC_VER > 1020
+
+#ifndef BOOST_FSM_REACHABILITY_HPP_INCLUDED_
+#define BOOST_FSM_REACHABILITY_HPP_INCLUDED_
+
+#include <boost/mpl/or.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/mpl/end.hpp>
+#include <boost/mpl/set.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/fold.hpp>
+#include <boost/mpl/begin.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/next.hpp>
+#include <boost/mpl/index_of.hpp>
+#include <boost/mpl/insert.hpp>
+#include <boost/mpl/has_key.hpp>
+#include <boost/mpl/find_if.hpp>
+#include <boost/mpl/copy_if.hpp>
+#include <boost/mpl/contains.hpp>
+#include <boost/mpl/placeholders.hpp>
+#include <boost/mpl/back_inserter.hpp>
+#include <boost/mpl/vector/vector0.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/fsm/detail/prologue.hpp>
+
+namespace boost {
+
+namespace fsm {
+
+namespace aux {
+
+    //! The metafunction detects if the state declares the list of states it may switch to
+    template< typename StateT >
+    struct has_declared_target_states :
+        public mpl::not_< is_same< typename StateT::target_states_type_list, void > >
+    {
+    };
+
+    //! The metafunction detects if the analysis is possible, which is the case if all states declare their target states
+    template< typename StateListT >
+    struct is_reachability_analysis_enabled :
+        public is_same<
+            typename mpl::find_if< StateListT, mpl::not_< has_declared_target_states< mpl::_1 > > >::type,
+            typename mpl::end< StateListT >::type
+        >::type
+    {
+    };
+
+    //! The metafunction adds the target states of the state to the set
+    template< typename SetT, typename StateT >
+    struct insert_target_states :
+        public mpl::fold< typename StateT::target_states_type_list, SetT, mpl::insert< mpl::_1, mpl::_2 > >
+    {
+    };
+
+    //! The metafunction adds the target states of all states in the set to the set
+    template< typename SetT >
+    struct reachability_step :
+        public mpl::fold< SetT, SetT, insert_target_states< mpl::_1, mpl::_2 > >
+    {
+    };
+
+    //! The metafunction repeats the reachability steps until the set of states stops growing
+    template<
+        typename SetT,
+        typename NextSetT = typename reachability_step< SetT >::type,
+        bool IsCompleteV = (mpl::size< SetT >::value == mpl::size< NextSetT >::value)
+    >
+    struct reachability_closure :
+        public reachability_closure< NextSetT >
+    {
+    };
+
+    template< typename SetT, typename NextSetT >
+    struct reachability_closure< SetT, NextSetT, true >
+    {
+        typedef SetT type;
+    };
+
+    //! The metafunction returns the set of states that are reachable from the initial state
+    template< typename StateListT >
+    struct reachable_states_set :
+        public reachability_closure<
+            mpl::set1< typename mpl::deref< typename mpl::begin< StateListT >::type >::type >
+        >
+    {
+    };
+
+    //! The metafunction detects if the state is in the set of states that are reachable from the initial state
+    template< typename StateListT, typename StateT >
+    struct is_state_in_reachable_set :
+        public mpl::has_key< typename reachable_states_set< StateListT >::type, StateT >::type
+    {
+    };
+
+    //! The metafunction detects if the state may become active. All states are considered reachable if the analysis is not possible.
+    template< typename StateListT, typename StateT >
+    struct is_state_reachable :
+        public mpl::or_<
+            mpl::not_< is_reachability_analysis_enabled< StateListT > >,
+            is_state_in_reachable_set< StateListT, StateT >
+        >::type
+    {
+    };
+
+    //! The metafunction detects if the state is allowed to switch to the target state
+    template< typename StateT, typename TargetStateT >
+    struct is_target_state_declared :
+        public mpl::or_<
+            is_same< StateT, TargetStateT >,
+            mpl::not_< has_declared_target_states< StateT > >,
+            mpl::contains< typename StateT::target_states_type_list, TargetStateT >
+        >::type
+    {
+    };
+
+    //! The structure looks for the state identifier among the states in the [IteratorT, EndT) range
+    template< typename StateListT, typename IteratorT, typename EndT >
+    struct target_state_id_lookup
+    {
+        static bool find(unsigned int state_id)
+        {
+            typedef typename mpl::index_of< StateListT, typename mpl::deref< IteratorT >::type >::type state_index_type;
+            return (state_index_type::value == state_id ||
+                target_state_id_lookup< StateListT, typename mpl::next< IteratorT >::type, EndT >::find(state_id));
+        }
+    };
+    template< typename StateListT, typename EndT >
+    struct target_state_id_lookup< StateListT, EndT, EndT >
+    {
+        static bool find(unsigned int) { return false; }
+    };
+
+    //! The run-time counterpart of is_target_state_declared for the target states identified by their index in StateListT
+    template< typename StateListT, typename StateT, bool IsDeclaredV = has_declared_target_states< StateT >::value >
+    struct dynamic_target_state_check
+    {
+        static bool is_declared(unsigned int) { return true; }
+    };
+    template< typename StateListT, typename StateT >
+    struct dynamic_target_state_check< StateListT, StateT, true >
+    {
+        static bool is_declared(unsigned int state_id)
+        {
+            typedef typename StateT::target_states_type_list target_states_type_list;
+            return target_state_id_lookup<
+                StateListT,
+                typename mpl::begin< target_states_type_list >::type,
+                typename mpl::end< target_states_type_list >::type
+            >::find(state_id);
+        }
+    };
+
+} // namespace aux
+
+/*!
+*    \brief The compile-time report of the states reachability
+*
+*    The analysis is enabled if every state of the machine declares the states it may switch to in the nested
+*    target_states_type_list typedef. The states that are not reachable from the initial state are never
+*    activated, so the state machine does not generate event delivery code for them. If the analysis is not enabled,
+*    all states are considered reachable.
+*/
+template< typename StateMachineT >
+struct reachability
+{
+    //! States type sequence
+    typedef typename StateMachineT::states_type_list states_type_list;
+
+    //! The flag is true if the analysis is enabled
+    BOOST_STATIC_CONSTANT(bool, is_enabled = aux::is_reachability_analysis_enabled< states_type_list >::value);
+
+    //! The list of states that are reachable from the initial state
+    typedef typename mpl::copy_if<
+        states_type_list,
+        aux::is_state_reachable< states_type_list, mpl::_1 >,
+        mpl::back_inserter< mpl::vector0< > >
+    >::type reachable_states_type_list;
+
+    //! The list of states that are never reached from the initial state
+    typedef typename mpl::copy_if<
+        states_type_list,
+        mpl::not_< aux::is_state_reachable< states_type_list, mpl::_1 > >,
+        mpl::back_inserter< mpl::vector0< > >
+    >::type unreachable_states_type_list;
+};
+
+} // namespace fsm
+
+} // namespace boost
+
+#endif // BOOST_FSM_REACHABILITY_HPP_INCLUDED_
@@ -0,0 +1,165 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \file   result.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ *
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         error codes and result types for the non-throwing interface are implemented.
+ */
+
+#if (defined(_MSC_VER) && _MSC_VER > 1020)
+#pragma once
+#endif // _MSC_VER > 1020
+
+#ifndef BOOST_FSM_RESULT_HPP_INCLUDED_
+#define BOOST_FSM_RESULT_HPP_INCLUDED_
+
+#include <cstddef>
+#include <boost/assert.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/fsm/detail/prologue.hpp>
+
+namespace boost {
+
+namespace fsm {
+
+//! Error codes returned by the non-throwing interface of the library
+namespace errc {
+
+    //! Error codes enumeration
+    enum type
+    {
+        success = 0,            //!< Operation succeeded
+        bad_state_id,           //!< An invalid state identifier was used, see the bad_state_id exception
+        unexpected_event        //!< The event is not expected in the current state, see the unexpected_event exception
+    };
+
+} // namespace errc
+
+namespace aux {
+
+    //! A common base for result types
+    class result_base
+    {
+    private:
+        //! A type for the safe bool conversion
+        struct dummy { void true_value() {} };
+        //! Safe bool type
+        typedef void (dummy::*safe_bool_type)();
+
+    protected:
+        //! Operation status
+        errc::type m_Status;
+
+    protected:
+        //! Constructor
+        explicit result_base(errc::type status) : m_Status(status) {}
+
+    public:
+        //! The method returns the operation status
+        errc::type status() const { return m_Status; }
+        //! The method returns true if the operation succeeded
+        bool succeeded() const { return (m_Status == errc::success); }
+
+        //! Safe bool conversion, returns true if the operation succeeded
+        operator safe_bool_type() const { return (succeeded() ? &dummy::true_value : 0); }
+        //! Inverted conversion to bool
+        bool operator! () const { return !succeeded(); }
+    };
+
+} // namespace aux
+
+/*!
+*    \brief The result of an operation of the non-throwing interface
+*
+*    The object contains either the operation status or the operation status and the result value.
+*    The value may only be accessed if the operation succeeded.
+*/
+template< typename T >
+class result :
+    public aux::result_base
+{
+public:
+    //! Value type
+    typedef T value_type;
+
+private:
+    //! The value, it is only constructed if the operation succeeded
+    optional< value_type > m_Value;
+
+public:
+    //! Constructs a successful result
+    result(value_type const& value) : aux::result_base(errc::success), m_Value(value) {}
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    //! Constructs a successful result, the value is moved
+    result(value_type&& value) : aux::result_base(errc::success), m_Value(static_cast< value_type&& >(value)) {}
+#endif // !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    //! Constructs a failed result
+    explicit result(errc::type status) : aux::result_base(status) {}
+
+    //! An accessor to the value
+    value_type const& value() const
+    {
+        BOOST_ASSERT(succeeded());
+        return *m_Value;
+    }
+    //! An accessor to the value
+    value_type& value()
+    {
+        BOOST_ASSERT(succeeded());
+        return *m_Value;
+    }
+};
+
+//! The result for operations that return a reference
+template< typename T >
+class result< T& > :
+    public aux::result_base
+{
+public:
+    //! Value type
+    typedef T& value_type;
+
+private:
+    //! A pointer to the value
+    T* m_pValue;
+
+public:
+    //! Constructs a successful result
+    result(value_type value) : aux::result_base(errc::success), m_pValue(&value) {}
+    //! Constructs a failed result
+    explicit result(errc::type status) : aux::result_base(status), m_pValue(NULL) {}
+
+    //! An accessor to the value
+    value_type value() const
+    {
+        BOOST_ASSERT(succeeded());
+        return *m_pValue;
+    }
+};
+
+//! The result for operations that do not return a value
+template< >
+class result< void > :
+    public aux::result_base
+{
+public:
+    //! Value type
+    typedef void value_type;
+
+public:
+    //! Constructs a result
+    explicit result(errc::type status = errc::success) : aux::result_base(status) {}
+};
+
+} // namespace fsm
+
+} // namespace boost
+
+#endif // BOOST_FSM_RESULT_HPP_INCLUDED_
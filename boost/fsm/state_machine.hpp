@@ -20,13 +20,25 @@
 #define BOOST_FSM_STATE_MACHINE_HPP_INCLUDED_
 
 #include <cstddef>
+#include <climits>
+#include <bitset>
+#include <algorithm>
 #include <typeinfo>
+#include <boost/assert.hpp>
 #include <boost/throw_exception.hpp>
 #include <boost/static_assert.hpp>
+#include <boost/function/function2.hpp>
 #include <boost/function/function3.hpp>
 #include <boost/any.hpp>
 #include <boost/mpl/if.hpp>
+#include <boost/mpl/eval_if.hpp>
 #include <boost/mpl/bool.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/count_if.hpp>
+#include <boost/mpl/placeholders.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/mpl/next.hpp>
 #include <boost/mpl/size.hpp>
 #include <boost/mpl/index_of.hpp>
 #include <boost/mpl/begin.hpp>
@@ -38,15 +50,29 @@
 #include <boost/mpl/vector/vector0.hpp>
 #include <boost/type_traits/is_base_and_derived.hpp>
 #include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/detail/yes_no_type.hpp>
 #include <boost/preprocessor/cat.hpp>
 #include <boost/preprocessor/arithmetic/inc.hpp>
 #include <boost/preprocessor/arithmetic/dec.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+#include <boost/preprocessor/repetition/enum_params.hpp>
 #include <boost/preprocessor/repetition/enum_trailing.hpp>
+#include <boost/preprocessor/repetition/enum_trailing_params.hpp>
+#include <boost/preprocessor/repetition/enum_trailing_binary_params.hpp>
 #include <boost/preprocessor/repetition/repeat_from_to.hpp>
 #include <boost/preprocessor/iteration/iterate.hpp>
 #include <boost/detail/lightweight_call_once.hpp>
 #include <boost/fsm/detail/prologue.hpp>
 #include <boost/fsm/exceptions.hpp>
+#include <boost/fsm/result.hpp>
+#include <boost/fsm/next.hpp>
+#include <boost/fsm/reachability.hpp>
+#include <boost/fsm/transition.hpp>
+#include <boost/fsm/event.hpp>
+
+#if defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+#include <variant>
+#endif // defined(BOOST_FSM_HAS_VARIANT_EVENTS)
 
 namespace boost {
 
@@ -59,9 +85,9 @@ namespace aux {
     class basic_state;
     template< typename, typename, typename >
     class state_impl;
-    template< typename, typename, typename >
+    template< typename, typename, typename, typename >
     class basic_state_machine;
-    template< typename, typename >
+    template< typename, typename, typename >
     struct states_compound;
 
     //! This class is the most base for every state
@@ -76,19 +102,16 @@ namespace aux {
     //! An internal structure that holds information about a single state
     struct state_info
     {
-        //! get_state_name function type
-        typedef std::string const& (*get_state_name_fun_t)();
-
         //! Pointer shift between a pointer to state_root of a state
         //! and a pointer to state_machine_root of a complete state machine
         std::ptrdiff_t Shift;
         //! A pointer to type info of a state
-        std::type_info const* pTypeInfo;
-        //! A pointer to get_state_name function
-        get_state_name_fun_t pGetStateName;
+        type_info_t const* pTypeInfo;
+        //! A pointer to the state name, as returned by the state's get_state_name function
+        std::string const* pName;
 
         //! Constructor
-        state_info() : Shift(0), pTypeInfo(NULL), pGetStateName(NULL) {}
+        state_info() : Shift(0), pTypeInfo(NULL), pName(NULL) {}
     };
 
     //! The ultimate base class of a complete states compound. Every state virtually inherits this class.
@@ -110,8 +133,6 @@ namespace aux {
         state_id_t m_CurrentState;
         //! A pointer to array of information about states. The pointer is set right after construction.
         const state_info* m_pStatesInfo;
-        //! This function is called on unexpected event discovery. If it is empty the default logic will be used.
-        function3< return_type, any const&, std::type_info const&, state_id_t > m_UnexpectedEventHandler;
 
     public:
         //! Default constructor
@@ -133,7 +154,7 @@ namespace aux {
         *    \brief The method returns current state type info
         *    \throw None
         */
-        std::type_info const& get_current_state_type() const
+        type_info_t const& get_current_state_type() const
         {
             return (*m_pStatesInfo[m_CurrentState].pTypeInfo);
         }
@@ -142,7 +163,7 @@ namespace aux {
         *    \param state_id The identifier of the state
         *    \throw bad_state_id if the state_id argument is invalid
         */
-        std::type_info const& get_state_type(state_id_t state_id) const
+        type_info_t const& get_state_type(state_id_t state_id) const
         {
             if (state_id < states_count)
                 return (*m_pStatesInfo[state_id].pTypeInfo);
@@ -151,52 +172,40 @@ namespace aux {
         }
         /*!
         *    \brief The method returns current state name
-        *    \throw Nothing if the appropriate get_state_name function doesn't throw
+        *    \throw None
         */
         std::string const& get_current_state_name() const
         {
-            return (*m_pStatesInfo[m_CurrentState].pGetStateName)();
+            return (*m_pStatesInfo[m_CurrentState].pName);
         }
         /*!
         *    \brief The method returns a state name
         *    \param state_id The identifier of the state
-        *    \throw bad_state_id if the state_id argument is invalid or anything the appropriate get_state_name might throw
+        *    \throw bad_state_id if the state_id argument is invalid
         */
         std::string const& get_state_name(state_id_t state_id) const
         {
             if (state_id < states_count)
-                return (*m_pStatesInfo[state_id].pGetStateName)();
+                return (*m_pStatesInfo[state_id].pName);
             else
                 throw_exception(bad_state_id(state_id, get_current_state_name(), get_current_state_type(), get_current_state_id()));
         }
-
-    private:
-        /*!
-        *    \brief The method sets an unexpected events handler
-        *
-        *    The handler may be a functor or a pointer to function with the following signature:
-        *
-        *    return_type (any const&, std::type_info const&, state_id_t);
-        *
-        *    See the documentation for arguments description. Old handler, if it was, is lost.
-        *
-        *    \param handler New unexpected events handler.
-        *    \throw Nothing if function assignment operator doesn't throw
-        */
-        template< typename T >
-        void set_unexpected_event_handler(T const& handler)
-        {
-            m_UnexpectedEventHandler = handler;
-        }
         /*!
-        *    \brief The method resets the unexpected events handler to the default
-        *    \throw Nothing if function clear method doesn't throw
+        *    \brief The method returns a state name (non-throwing version)
+        *    \param state_id The identifier of the state
+        *    \return The state name or errc::bad_state_id if the state_id argument is invalid
+        *    \throw None
         */
-        void set_default_unexpected_event_handler()
+        result< std::string const& > try_get_state_name(state_id_t state_id) const
         {
-            m_UnexpectedEventHandler.clear();
+            typedef result< std::string const& > result_type;
+            if (state_id < states_count)
+                return result_type(*m_pStatesInfo[state_id].pName);
+            else
+                return result_type(errc::bad_state_id);
         }
 
+    private:
     private:
         //! The method sets a pointer to array of states information array. The method is called right after construction.
         void _set_states_info(const state_info* pStatesInfo)
@@ -213,15 +222,6 @@ namespace aux {
         {
             return m_pStatesInfo[state_id];
         }
-        //! The method invokes unexpected events handler or throws unexpected_event if no handler is set
-        return_type _on_unexpected_event(any const& evt, std::type_info const& state_type, state_id_t state_id)
-        {
-            if (!m_UnexpectedEventHandler.empty())
-                return m_UnexpectedEventHandler(evt, state_type, state_id);
-            else
-                throw_exception(unexpected_event(evt, get_current_state_name(), state_type, state_id));
-        }
-
         //  This is just a protection against attempts to create a standalone state object
         virtual void _creating_a_separate_state_object_is_prohibited_(private_type) = 0;
 
@@ -230,9 +230,9 @@ namespace aux {
         friend class basic_state;
         template< typename, typename, typename >
         friend class state_impl;
-        template< typename, typename, typename >
+        template< typename, typename, typename, typename >
         friend class basic_state_machine;
-        template< typename, typename >
+        template< typename, typename, typename >
         friend struct states_compound;
     };
 
@@ -275,16 +275,20 @@ namespace aux {
         *    User should override this typedef in the derived state class to define his own transitions.
         */
         typedef mpl::vector0< > transitions_type_list;
+        /*!
+        *    \brief The list of states this state may switch to (not declared by default).
+        *
+        *    User may override this typedef in the derived state class to enable the states reachability analysis.
+        *    The list must contain all states that the state switches to with switch_to, transitions and next state
+        *    handler results. This is checked at compile time, except for the dynamic version of switch_to.
+        */
+        typedef void target_states_type_list;
 
         //! States count import
         BOOST_STATIC_CONSTANT(unsigned int, states_count = root_type::states_count);
         //! State identifier
         BOOST_STATIC_CONSTANT(state_id_t, state_id = state_index_type::value);
 
-    private:
-        //! A pointer to the default state name
-        static std::string const& g_DefaultStateName;
-
     public:
         /*!
         *    \brief The method performs a transition to another state (static version)
@@ -293,6 +297,9 @@ namespace aux {
         template< typename AnotherStateT >
         void switch_to()
         {
+            //  Static check for that the target state is declared in target_states_type_list, if the list is declared
+            BOOST_STATIC_ASSERT((is_target_state_declared< StateT, AnotherStateT >::value));
+
             typedef typename mpl::index_of< StateListT, AnotherStateT >::type next_state_index_type;
             const state_id_t next_state_id = next_state_index_type::value;
 
@@ -326,6 +333,9 @@ namespace aux {
 
         /*!
         *    \brief The method performs a transition to another state (dynamic version)
+        *
+        *    If the state declares target_states_type_list, the target state must be in the list. This is checked with BOOST_ASSERT.
+        *
         *    \param next_state_id Target state identifier
         *    \throw bad_state_id if next_state_id is not valid or anything on_enter_state or on_leave_state might throw
         */
@@ -335,25 +345,36 @@ namespace aux {
             {
                 if (next_state_id < states_count)
                 {
-                    // Notify the current state about leaving
-                    register StateT* const pThis = static_cast< StateT* >(this);
-                    pThis->on_leave_state();
-                    // Notify the target state about entering
-                    state_info const& info = root_type::_get_state_info(next_state_id);
-                    register state_root* const pThat =
-                        reinterpret_cast< state_root* >(
-                        reinterpret_cast< char* >(static_cast< root_type* >(this)) + info.Shift);
-                    pThat->on_enter_state();
-                    // Change current state
-                    root_type::_set_current_state(next_state_id);
+                    // The dynamic counterpart of the target state check in the static version
+                    BOOST_ASSERT((dynamic_target_state_check< StateListT, StateT >::is_declared(next_state_id)));
+                    _switch_to(next_state_id);
                 }
                 else
                 {
                     // Invalid state identifier detected
-                    throw_exception(bad_state_id(next_state_id, root_type::get_current_state_name(), typeid(StateT), state_id));
+                    throw_exception(bad_state_id(next_state_id, root_type::get_current_state_name(), type_info_of< StateT >(), state_id));
                 }
             }
         }
+        /*!
+        *    \brief The method performs a transition to another state (dynamic non-throwing version)
+        *    \param next_state_id Target state identifier
+        *    \return errc::bad_state_id if next_state_id is not valid or, if the state declares target_states_type_list,
+        *            not in the list, errc::success otherwise
+        *    \throw Nothing unless on_enter_state or on_leave_state throws
+        */
+        result< void > try_switch_to(state_id_t next_state_id)
+        {
+            if (next_state_id == state_id)
+                return result< void >();
+            else if (next_state_id < states_count && dynamic_target_state_check< StateListT, StateT >::is_declared(next_state_id))
+            {
+                _switch_to(next_state_id);
+                return result< void >();
+            }
+            else
+                return result< void >(errc::bad_state_id);
+        }
 
         //! Default implementation of state enter handler to support its optionality
         void on_enter_state() {}
@@ -367,42 +388,47 @@ namespace aux {
         //! on_process handlers in the state.
         return_type on_process(private_type);
 
-        //! An accessor to the default state name
+        /*!
+        *    \brief An accessor to the default state name
+        *
+        *    The name is constructed on the first call from the compile-time type information, no demangling is involved.
+        *    The state machine calls this function once per state when the first state machine object is constructed.
+        */
         static std::string const& get_state_name()
         {
-            // This is thread-safe, since the reference have been initialized from make_state_name
-            // that was already called from dynamic_initialization
-            return g_DefaultStateName;
+            static detail::lw_call_once::call_once_trigger trigger = BOOST_LWCO_INIT;
+            detail::lw_call_once::call_once(trigger, &basic_state::make_state_name);
+            return make_state_name();
         }
 
     private:
-        //! The method performs dynamic state initialization
-        static std::string const& dynamic_initialization()
+        //! The method performs a transition to another state with a valid identifier
+        void _switch_to(state_id_t next_state_id)
         {
-            static detail::lw_call_once::call_once_trigger trigger = BOOST_LWCO_INIT;
-            detail::lw_call_once::call_once(trigger, &basic_state::make_state_name);
-            return make_state_name();
+            // Notify the current state about leaving
+            register StateT* const pThis = static_cast< StateT* >(this);
+            pThis->on_leave_state();
+            // Notify the target state about entering
+            state_info const& info = root_type::_get_state_info(next_state_id);
+            register state_root* const pThat =
+                reinterpret_cast< state_root* >(
+                reinterpret_cast< char* >(static_cast< root_type* >(this)) + info.Shift);
+            pThat->on_enter_state();
+            // Change current state
+            root_type::_set_current_state(next_state_id);
         }
 
         //! A state name construction helper
         static std::string const& make_state_name()
         {
-            static const std::string name(construct_type_name(typeid(StateT)));
+            static const std::string name(construct_type_name< StateT >());
             return name;
         }
 
-        template< typename, typename, typename >
+        template< typename, typename, typename, typename >
         friend class basic_state_machine;
     };
 
-    //! A pointer to the default state name
-    template< typename StateT, typename StateListT, typename RetValT >
-    std::string const& basic_state<
-        StateT,
-        StateListT,
-        RetValT
-    >::g_DefaultStateName = basic_state< StateT, StateListT, RetValT >::dynamic_initialization();
-
     //! A super-class for state that detects unexpected events
     template< typename StateT, typename StateListT, typename RetValT >
     class BOOST_FSM_NO_VTABLE state_impl :
@@ -425,16 +451,20 @@ namespace aux {
     public:
         //! State machine return type import
         typedef typename base_type::return_type return_type;
+        //! MPL-style boolean constant that is true if unexpected events in the state are passed to the state machine handler
+        typedef typename is_same< unexpected_event_holder_type, any_event >::type is_unexpected_event_forwarded;
 
     public:
         //  on_process handlers import from state class
         using state_type::on_process;
 
-        //! This on_process handler will be called if no appropriate handler found in the state
-        return_type on_process(unexpected_event_holder_type const& evt)
-        {
-            return root_type::_on_unexpected_event(evt.value, typeid(StateT), base_type::state_id);
-        }
+        /*!
+        *    \brief This on_process handler will be chosen if no appropriate handler found in the state
+        *
+        *    The handler is never called: the state machine delivers unexpected events to
+        *    the unexpected events handler directly, and states that must handle all events fail to compile.
+        */
+        return_type on_process(unexpected_event_holder_type const& evt);
     };
 
 //! The macro allows to enforce all possible events support in the state
@@ -464,10 +494,235 @@ namespace aux {
         };
     };
 
+    /*!
+    *    \brief The metafunction looks for a transition rule applicable to the state and the event
+    *
+    *    The rules defined in the state are looked up first, then the ones in the state machine transitions map.
+    */
+    template< typename StateT, typename EventT, typename TransitionListT >
+    struct find_transition
+    {
+        //! The complete transitions list, including ones that are defined in the state
+        typedef mpl::joint_view<
+            typename StateT::transitions_type_list,
+            TransitionListT
+        > complete_transitions_type_list;
+
+        //! An iterator to the applicable transition
+        typedef typename mpl::find_if<
+            complete_transitions_type_list,
+            applicable_transition_pred< StateT, EventT >
+        >::type type;
+
+        //! MPL-style boolean constant that is true if there is no applicable transition
+        typedef typename is_same<
+            type,
+            typename mpl::end< complete_transitions_type_list >::type
+        >::type is_not_found;
+    };
+
+    //! The type returned by the unexpected events probe handler
+    struct unexpected_event_probe_result {};
+
+    //! This structure is used to detect unexpected events at compile time. It may be constructed from any type.
+    struct unexpected_event_probe
+    {
+        //! Constructor (never defined, the structure is only used in unevaluated context)
+        template< typename T >
+        unexpected_event_probe(T const&);
+    };
+
+    //! An auxiliary type to make void-returning handler calls usable in unevaluated context
+    struct void_handler_result {};
+
+    //! The operator turns a non-void handler result into a reference to it (never defined)
+    template< typename T >
+    T const& operator, (T const&, void_handler_result const&);
+
+    //! An auxiliary class that imports event handlers of a state and adds the unexpected events probe to them
+    template< typename StateT >
+    struct BOOST_FSM_NO_VTABLE event_handlers_probe :
+        protected StateT
+    {
+        //  on_process handlers import from state class
+        using StateT::on_process;
+
+        //! This handler will be chosen by the overload resolution if no appropriate handler is found in the state
+        static unexpected_event_probe_result on_process(unexpected_event_probe const&);
+
+        //! Object reference generator (never defined)
+        static event_handlers_probe& instance();
+        //! Event reference generator (never defined)
+        template< typename EventT >
+        static EventT const& event();
+
+        //! Handler result classifiers (never defined)
+        static type_traits::yes_type classify(unexpected_event_probe_result const&);
+        static type_traits::no_type classify(...);
+        static type_traits::yes_type classify_next(next_base const&);
+        static type_traits::no_type classify_next(...);
+    };
+
+    /*!
+    *    \brief The metafunction detects if the state has an on_process handler that accepts the event
+    *
+    *    The check exactly reproduces the overload resolution that takes place on the event delivery,
+    *    except that the state's unexpected events holder is never considered. This allows to check
+    *    states with BOOST_FSM_MUST_HANDLE_ALL_EVENTS without triggering the compile-time assertion.
+    */
+    template< typename StateT, typename EventT >
+    struct is_event_handled :
+        public mpl::bool_<
+            sizeof(event_handlers_probe< StateT >::classify((
+                event_handlers_probe< StateT >::instance().on_process(
+                    event_handlers_probe< StateT >::BOOST_NESTED_TEMPLATE event< EventT >()),
+                void_handler_result()))) == sizeof(type_traits::no_type)
+        >
+    {
+    };
+
+    //! The metafunction detects if the state handler that accepts the event returns the next state
+    template< typename StateT, typename EventT >
+    struct is_next_state_returned :
+        public mpl::bool_<
+            sizeof(event_handlers_probe< StateT >::classify_next((
+                event_handlers_probe< StateT >::instance().on_process(
+                    event_handlers_probe< StateT >::BOOST_NESTED_TEMPLATE event< EventT >()),
+                void_handler_result()))) == sizeof(type_traits::yes_type)
+        >
+    {
+    };
+
+    //! The metafunction detects if the state either handles the event or has a transition on it
+    template< typename StateT, typename EventT, typename TransitionListT >
+    struct is_event_accepted :
+        public mpl::or_<
+            mpl::not_< typename find_transition< StateT, EventT, TransitionListT >::is_not_found >,
+            is_event_handled< StateT, EventT >
+        >::type
+    {
+    };
+
+    //! The metafunction detects if the event is delivered to the state rather than to the unexpected events handler
+    template< typename StateT, typename EventT, typename StateListT, typename RetValT >
+    struct is_event_delivered_to_state :
+        public mpl::or_<
+            is_event_handled< StateT, EventT >,
+            // Let the state detect unexpected events by itself if it wants to
+            mpl::not_< typename state_impl< StateT, StateListT, RetValT >::is_unexpected_event_forwarded >
+        >::type
+    {
+    };
+
+
+    //! The structure performs the transition to the state selected by the next state object
+    template< typename IteratorT, typename EndT >
+    struct next_state_switch
+    {
+        template< typename StateT >
+        static BOOST_FSM_FORCEINLINE void apply(StateT& state, unsigned int index)
+        {
+            if (index == 0)
+                state.BOOST_NESTED_TEMPLATE switch_to< typename mpl::deref< IteratorT >::type >();
+            else
+                next_state_switch< typename mpl::next< IteratorT >::type, EndT >::apply(state, index - 1);
+        }
+    };
+    template< typename EndT >
+    struct next_state_switch< EndT, EndT >
+    {
+        template< typename StateT >
+        static BOOST_FSM_FORCEINLINE void apply(StateT&, unsigned int) {}
+    };
+
+    /*!
+    *    \brief The metafunction detects if the event is passed to the unexpected events handler in the state
+    *
+    *    This is the case if the state neither handles the event nor has a transition on it, or if the state is never
+    *    active. The dispatching tables share a single entry for all such states.
+    */
+    template< typename StateMachineT, typename StateT, typename EventT >
+    struct is_event_unexpected :
+        public mpl::or_<
+            // The states that never become active are treated as if they do not accept any events
+            mpl::not_< is_state_reachable< typename StateMachineT::states_type_list, StateT > >,
+            mpl::and_<
+                typename find_transition< StateT, EventT, typename StateMachineT::transitions_type_list >::is_not_found,
+                mpl::not_<
+                    is_event_delivered_to_state<
+                        StateT,
+                        EventT,
+                        typename StateMachineT::states_type_list,
+                        typename StateMachineT::return_type
+                    >
+                >
+            >
+        >::type
+    {
+    };
+
+
+    //! The metafunction detects if the event is expected in the target state of the transition, if the target is known at compile time
+    template< typename StateMachineT, typename TransitionT, typename EventT >
+    struct is_event_expected_after_transition
+    {
+        typedef typename static_transition_target< TransitionT >::type target_state_type;
+        typedef typename mpl::eval_if<
+            is_same< target_state_type, void >,
+            // The target state is only known in run time
+            mpl::true_,
+            mpl::not_< is_event_unexpected< StateMachineT, target_state_type, EventT > >
+        >::type type;
+    };
+
+    /*!
+    *    \brief The metafunction detects if the event is accepted in the state and is not passed to the unexpected events
+    *           handler after the transition, in the sense of the try_process method
+    */
+    template< typename StateMachineT, typename StateT, typename EventT >
+    struct is_event_accepted_by_target
+    {
+        typedef find_transition< StateT, EventT, typename StateMachineT::transitions_type_list > transition_lookup_t;
+        typedef typename mpl::eval_if<
+            typename transition_lookup_t::is_not_found,
+            is_event_handled< StateT, EventT >,
+            is_event_expected_after_transition< StateMachineT, typename mpl::deref< typename transition_lookup_t::type >::type, EventT >
+        >::type type;
+    };
+
 
     //! An auxiliary structure that contains friendly functions for state machine implementation
     struct state_machine_access
     {
+        //! The method sets the event delivery function for the case when the state handles the event by itself
+        template< typename StateMachineT, typename StateT, typename EventT, typename ProcessFunT >
+        BOOST_FSM_FORCEINLINE static void do_init_delivery_function(ProcessFunT& process_fun, mpl::true_ const&)
+        {
+            process_fun = &StateMachineT::BOOST_NESTED_TEMPLATE deliver_event< StateT, EventT >;
+        }
+        //! The method sets the event delivery function for the case when the event is unexpected in the state
+        template< typename StateMachineT, typename StateT, typename EventT, typename ProcessFunT >
+        BOOST_FSM_FORCEINLINE static void do_init_delivery_function(ProcessFunT& process_fun, mpl::false_ const&)
+        {
+            // There's no need to pass the event through the state's unexpected events holder,
+            // which would copy the event, we can call the unexpected events handler right away.
+            // The function does not depend on the state, so all states share it.
+            process_fun = &StateMachineT::BOOST_NESTED_TEMPLATE deliver_unexpected_event< EventT >;
+        }
+        //! The method sets the event delivery function
+        template< typename StateMachineT, typename StateT, typename EventT, typename ProcessFunT >
+        BOOST_FSM_FORCEINLINE static void init_delivery_function(ProcessFunT& process_fun)
+        {
+            typedef typename is_event_delivered_to_state<
+                StateT,
+                EventT,
+                typename StateMachineT::states_type_list,
+                typename StateMachineT::return_type
+            >::type is_handled_by_state_t;
+
+            do_init_delivery_function< StateMachineT, StateT, EventT >(process_fun, is_handled_by_state_t());
+        }
+
         //! The method fills dispatching map element for the case when no transition is to be performed
         template< typename StateMachineT, typename StateT, typename TransitionItT, typename EventT, typename ProcessFuncsT >
         BOOST_FSM_FORCEINLINE static void do_init_process_functions(ProcessFuncsT* process_funcs, mpl::true_ const&)
@@ -477,8 +732,8 @@ namespace aux {
             // The "second" still needs to be valid because there may exist automatic
             // transitions to this state, and the "second" part of the pair will be used
             // in perform_transition method of that transition.
-            process_funcs->second = process_funcs->first =
-                &StateMachineT::BOOST_NESTED_TEMPLATE deliver_event< StateT, EventT >;
+            init_delivery_function< StateMachineT, StateT, EventT >(process_funcs->second);
+            process_funcs->first = process_funcs->second;
         }
         //! The method fills dispatching map element for the case when a transition has to be performed
         template< typename StateMachineT, typename StateT, typename TransitionItT, typename EventT, typename ProcessFuncsT >
@@ -486,7 +741,45 @@ namespace aux {
         {
             process_funcs->first = &StateMachineT::BOOST_NESTED_TEMPLATE perform_transition<
                 StateT, typename mpl::deref< TransitionItT >::type, EventT >;
-            process_funcs->second = &StateMachineT::BOOST_NESTED_TEMPLATE deliver_event< StateT, EventT >;
+            init_delivery_function< StateMachineT, StateT, EventT >(process_funcs->second);
+        }
+
+        //! The method fills dispatching map element for the state that may become active
+        template< typename StateMachineT, typename StateT, typename EventT, typename ProcessFuncsT >
+        BOOST_FSM_FORCEINLINE static void init_reachable_state_process_functions(ProcessFuncsT* process_funcs, mpl::true_ const&)
+        {
+            // Find an applicable transition in transitions map
+            typedef find_transition<
+                StateT,
+                EventT,
+                typename StateMachineT::transitions_type_list
+            > transition_lookup_t;
+            typedef typename transition_lookup_t::type transition_it_t;
+            typedef typename transition_lookup_t::is_not_found is_no_transition_found_t;
+
+            // Fill actual function pointers
+            do_init_process_functions<
+                StateMachineT,
+                StateT,
+                transition_it_t,
+                EventT,
+                ProcessFuncsT
+            >(process_funcs, is_no_transition_found_t());
+        }
+        //! The method fills dispatching map element for the state that is never active
+        template< typename StateMachineT, typename StateT, typename EventT, typename ProcessFuncsT >
+        BOOST_FSM_FORCEINLINE static void init_reachable_state_process_functions(ProcessFuncsT* process_funcs, mpl::false_ const&)
+        {
+            // The entry is never used, so we don't instantiate any state-specific code for it
+            process_funcs->first = process_funcs->second =
+                &StateMachineT::BOOST_NESTED_TEMPLATE deliver_unexpected_event< EventT >;
+        }
+        //! The method fills dispatching map element for the state
+        template< typename StateMachineT, typename StateT, typename EventT, typename ProcessFuncsT >
+        BOOST_FSM_FORCEINLINE static void init_process_functions(ProcessFuncsT* process_funcs)
+        {
+            typedef typename is_state_reachable< typename StateMachineT::states_type_list, StateT >::type is_reachable_t;
+            init_reachable_state_process_functions< StateMachineT, StateT, EventT >(process_funcs, is_reachable_t());
         }
     };
 
@@ -567,6 +860,16 @@ namespace aux {
                 StateMachineT, EventT, ProcessFuncsT
             >(process_funcs);
         }
+
+        //! The method recursively passes every state type to the visitor
+        template< typename VisitorT >
+        static BOOST_FSM_FORCEINLINE void for_each_state(VisitorT& visitor)
+        {
+#define BOOST_PP_ITERATION_LIMITS (1, 5)
+#define BOOST_PP_FILENAME_1 <boost/fsm/detail/inh_st_for_each_state.hpp>
+#include BOOST_PP_ITERATE()
+            rest_states::for_each_state(visitor);
+        }
     };
 
 //  Make specializations for 1 - 5 states in the list
@@ -579,15 +882,73 @@ namespace aux {
     struct inherited_states< StateListT, RetValT, typename mpl::end< StateListT >::type, 0 >;
 
 
+    //! Unexpected events handler storage. Statically configured handler policies need no storage.
+    template< typename RetValT, typename UnexpectedHandlerT >
+    struct unexpected_event_handler_storage
+    {
+    };
+
+    //! Unexpected events handler storage for the handler that is set in run time
+    template< typename RetValT >
+    class unexpected_event_handler_storage< RetValT, void >
+    {
+    private:
+        //! This function is called on unexpected event discovery. If it is empty the default logic will be used.
+        function3< RetValT, any const&, type_info_t const&, state_id_t > m_UnexpectedEventHandler;
+
+    public:
+        /*!
+        *    \brief The method sets an unexpected events handler
+        *
+        *    The handler may be a functor or a pointer to function with the following signature:
+        *
+        *    return_type (any const&, type_info_t const&, state_id_t);
+        *
+        *    See the documentation for arguments description. Old handler, if it was, is lost.
+        *
+        *    \param handler New unexpected events handler.
+        *    \throw Nothing if function assignment operator doesn't throw
+        */
+        template< typename T >
+        void set_unexpected_event_handler(T const& handler)
+        {
+            m_UnexpectedEventHandler = handler;
+        }
+        /*!
+        *    \brief The method resets the unexpected events handler to the default
+        *    \throw Nothing if function clear method doesn't throw
+        */
+        void set_default_unexpected_event_handler()
+        {
+            m_UnexpectedEventHandler.clear();
+        }
+
+        /*!
+        *    \brief The method invokes unexpected events handler or throws unexpected_event if no handler is set
+        *
+        *    The event is only copied into boost::any when it is about to be passed to the handler or the exception.
+        *    The borrowed event arguments are copied as views, the memory they refer to is not copied.
+        */
+        template< typename EventT, typename RootT >
+        RetValT on_unexpected_event(RootT const& root, EventT const& evt, type_info_t const& state_type, state_id_t state_id)
+        {
+            if (!m_UnexpectedEventHandler.empty())
+                return m_UnexpectedEventHandler(any(evt), state_type, state_id);
+            else
+                throw_exception(unexpected_event(any(evt), root.get_current_state_name(), state_type, state_id));
+        }
+    };
+
     //! A compound class that contains all states
-    template< typename StateListT, typename RetValT >
+    template< typename StateListT, typename RetValT, typename UnexpectedHandlerT >
     struct states_compound :
         public inherited_states<
             StateListT,
             RetValT,
             typename mpl::begin< StateListT >::type,
             mpl::size< StateListT >::value
-        >
+        >,
+        public unexpected_event_handler_storage< RetValT, UnexpectedHandlerT >
     {
     private:
         //! Base type
@@ -615,77 +976,738 @@ namespace aux {
         //  This friend declaration is needed to have the ability to cast
         //  pointers and references to states_compound object to pointers and references
         //  to states and their bases, including state_machine_root
-        template< typename, typename, typename >
+        template< typename, typename, typename, typename >
         friend class basic_state_machine;
     };
 
 
-    //! A class used to dispatch a call to state machine's process method depending on its current state
+    //! The metafunction counts the states in which the event is not passed to the unexpected events handler right away
     template< typename EventT, typename StateMachineT >
-    class state_dispatcher
+    struct accepting_states_count :
+        public mpl::count_if<
+            typename StateMachineT::states_type_list,
+            mpl::not_< is_event_unexpected< StateMachineT, mpl::_1, EventT > >
+        >::type
     {
-    private:
-        //! State machine base class
-        typedef StateMachineT state_machine_type;
-        //! The event type
-        typedef EventT event_type;
-        //! State machine return type
-        typedef typename state_machine_type::return_type return_type;
-        //! States compound type
-        typedef typename state_machine_type::states_compound_type states_compound_type;
-        //! Function type used to process event in a single state
-        typedef return_type (BOOST_FSM_FASTCALL* process_fun_t)(states_compound_type&, event_type const&);
-        //! A dispatching map entry type (we need to guarantee that it's POD, so we can't use std::pair here)
-        struct entry
-        {
-            //! A function pointer to be called to execute transition
-            process_fun_t first;
-            //! A function pointer to be called to deliver the event
-            process_fun_t second;
-        };
+    };
 
-    private:
-        //! The array is used to call the process_internal function that corresponds to the current state
-        entry m_Entries[state_machine_type::states_count];
+    /*!
+    *    \brief The metafunction decides whether the dispatching table for the event should be compressed
+    *
+    *    The compressed table is chosen if it takes at most half of the memory of the dense table.
+    *    The compression may be disabled by defining BOOST_FSM_NO_COMPRESSED_DISPATCH_TABLES.
+    */
+    template< typename EntryT, unsigned int StatesCountV, unsigned int MaxEntriesV >
+    struct is_dispatching_table_compressed :
+        public mpl::bool_<
+#if !defined(BOOST_FSM_NO_COMPRESSED_DISPATCH_TABLES)
+            MaxEntriesV <= 65536u
+            && (MaxEntriesV * sizeof(EntryT) + StatesCountV * (MaxEntriesV <= 256u ? 1u : 2u)) * 2u <= StatesCountV * sizeof(EntryT)
+#else
+            false
+#endif // !defined(BOOST_FSM_NO_COMPRESSED_DISPATCH_TABLES)
+        >
+    {
+    };
 
-        //! The only dispatcher instance
-        static state_dispatcher const g_Instance;
+    //! Dense dispatching table, contains an entry for every state
+    template<
+        typename EntryT,
+        unsigned int StatesCountV,
+        unsigned int MaxEntriesV,
+        bool IsCompressedV = is_dispatching_table_compressed< EntryT, StatesCountV, MaxEntriesV >::value
+    >
+    class dispatching_table
+    {
+    private:
+        //! Entries for every state
+        EntryT m_Entries[StatesCountV];
 
     public:
-        //! Default constructor
-        BOOST_FSM_NOINLINE state_dispatcher()
+        //! The method fills the table, the filler is called with the pointer to the array of entries for all states
+        template< typename FillerT >
+        void init(FillerT const& filler)
         {
-            // Race condition is possible here if the dynamic initialization
-            // of the namespace-scope static variables is performed concurrently.
-            // But even if it is executed in multiple threads concurrently
-            // the race between threads is not significant since only POD types
-            // are involved and the result of initialization does not depend on
-            // number of threads or number of initializations.
-            states_compound_type::BOOST_NESTED_TEMPLATE init_process_functions<
-                state_machine_type, event_type, entry
-            >(m_Entries);
+            filler(m_Entries);
         }
 
-        //! The subscript operator is used to get the appropriate function pointer
-        BOOST_FSM_FORCEINLINE entry const& operator[] (state_id_t state_id) const
+        //! The subscript operator returns the entry for the state
+        BOOST_FSM_FORCEINLINE EntryT const& operator[] (state_id_t state_id) const
         {
             return m_Entries[state_id];
         }
+    };
 
-        //! The method returns a reference to the only dispatcher instance
-        static BOOST_FSM_FORCEINLINE state_dispatcher const& get()
+    /*!
+    *    \brief Compressed dispatching table
+    *
+    *    The table contains only distinct entries, and a small index of the entry for every state.
+    *    Since all states that do not accept the event share the same entry, the number of distinct entries
+    *    does not exceed the number of states that accept the event plus one.
+    */
+    template< typename EntryT, unsigned int StatesCountV, unsigned int MaxEntriesV >
+    class dispatching_table< EntryT, StatesCountV, MaxEntriesV, true >
+    {
+    private:
+        //! Entry index type
+        typedef typename mpl::if_c< (MaxEntriesV <= 256u), unsigned char, unsigned short >::type index_type;
+
+    private:
+        //! Entry indices for every state
+        index_type m_Indices[StatesCountV];
+        //! Distinct entries
+        EntryT m_Entries[MaxEntriesV];
+
+    public:
+        //! The method fills the table, the filler is called with the pointer to the array of entries for all states
+        template< typename FillerT >
+        void init(FillerT const& filler)
+        {
+            EntryT entries[StatesCountV];
+            filler(entries);
+
+            unsigned int entries_count = 0;
+            for (unsigned int i = 0; i < StatesCountV; ++i)
+            {
+                unsigned int index = 0;
+                while (index < entries_count
+                    && (m_Entries[index].first != entries[i].first || m_Entries[index].second != entries[i].second))
+                {
+                    ++index;
+                }
+
+                if (index == entries_count)
+                {
+                    BOOST_ASSERT(entries_count < MaxEntriesV);
+                    m_Entries[entries_count++] = entries[i];
+                }
+
+                m_Indices[i] = static_cast< index_type >(index);
+            }
+        }
+
+        //! The subscript operator returns the entry for the state
+        BOOST_FSM_FORCEINLINE EntryT const& operator[] (state_id_t state_id) const
+        {
+            return m_Entries[m_Indices[state_id]];
+        }
+    };
+
+    //! A class used to dispatch a call to state machine's process method depending on its current state
+    template< typename EventT, typename StateMachineT >
+    class state_dispatcher
+    {
+    private:
+        //! State machine base class
+        typedef StateMachineT state_machine_type;
+        //! The event type
+        typedef EventT event_type;
+        //! State machine return type
+        typedef typename state_machine_type::return_type return_type;
+        //! States compound type
+        typedef typename state_machine_type::states_compound_type states_compound_type;
+        //! Function type used to process event in a single state
+        typedef return_type (BOOST_FSM_FASTCALL* process_fun_t)(states_compound_type&, event_type const&);
+        //! A dispatching map entry type (we need to guarantee that it's POD, so we can't use std::pair here)
+        struct entry
+        {
+            //! A function pointer to be called to execute transition
+            process_fun_t first;
+            //! A function pointer to be called to deliver the event
+            process_fun_t second;
+        };
+
+        //! The functor fills the array of entries for all states
+        struct filler
+        {
+            void operator() (entry* pEntries) const
+            {
+                states_compound_type::BOOST_NESTED_TEMPLATE init_process_functions<
+                    state_machine_type, event_type, entry
+                >(pEntries);
+            }
+        };
+
+        //! Dispatching table type. The table may be compressed if only a few states accept the event.
+        typedef dispatching_table<
+            entry,
+            state_machine_type::states_count,
+            accepting_states_count< event_type, state_machine_type >::value + 1
+        > table_type;
+
+    private:
+        //! The table is used to call the process_internal function that corresponds to the current state
+        table_type m_Table;
+
+        //! The only dispatcher instance
+        static state_dispatcher const g_Instance;
+
+    public:
+        //! Default constructor
+        BOOST_FSM_NOINLINE state_dispatcher()
+        {
+            // Race condition is possible here if the dynamic initialization
+            // of the namespace-scope static variables is performed concurrently.
+            // But even if it is executed in multiple threads concurrently
+            // the race between threads is not significant since only POD types
+            // are involved and the result of initialization does not depend on
+            // number of threads or number of initializations.
+            m_Table.init(filler());
+        }
+
+        //! The subscript operator is used to get the appropriate function pointer
+        BOOST_FSM_FORCEINLINE entry const& operator[] (state_id_t state_id) const
+        {
+            return m_Table[state_id];
+        }
+
+        //! The method returns a reference to the only dispatcher instance
+        static BOOST_FSM_FORCEINLINE state_dispatcher const& get()
+        {
+            return g_Instance;
+        }
+    };
+
+    //! Implementation of the state dispatchers
+    template< typename EventT, typename StateMachineT >
+    state_dispatcher< EventT, StateMachineT > const state_dispatcher< EventT, StateMachineT >::g_Instance;
+
+#if defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+
+    /*!
+    *    \brief A class used to dispatch a variant of events depending on the current state and the variant index
+    *
+    *    The dispatcher holds a single table of functions, indexed by the state identifier and the variant index.
+    *    Each function extracts the event from the variant and processes it in the state with no further dispatch,
+    *    unless an automatic transition takes place.
+    */
+    template< typename VariantT, typename StateMachineT >
+    class variant_dispatcher
+    {
+    private:
+        //! State machine base class
+        typedef StateMachineT state_machine_type;
+        //! The variant type
+        typedef VariantT variant_type;
+        //! State machine return type
+        typedef typename state_machine_type::return_type return_type;
+        //! States compound type
+        typedef typename state_machine_type::states_compound_type states_compound_type;
+        //! Function type used to process the variant in a single state
+        typedef return_type (BOOST_FSM_FASTCALL* process_fun_t)(states_compound_type&, variant_type const&);
+
+    public:
+        //! Number of variant alternatives
+        BOOST_STATIC_CONSTANT(std::size_t, alternatives_count = std::variant_size< variant_type >::value);
+
+    private:
+        //! A visitor that fills the table column for the variant alternative
+        template< std::size_t IndexV >
+        struct initializer
+        {
+            process_fun_t (*m_pRows)[alternatives_count];
+
+            explicit initializer(process_fun_t (*pRows)[alternatives_count]) : m_pRows(pRows) {}
+
+            template< typename StateT >
+            void visit()
+            {
+                typedef typename std::variant_alternative< IndexV, variant_type >::type event_type;
+                init_entry< StateT >(typename is_event_unexpected< state_machine_type, StateT, event_type >::type());
+            }
+
+            template< typename StateT >
+            void init_entry(mpl::false_ const&)
+            {
+                m_pRows[StateT::state_id][IndexV] =
+                    &state_machine_type::BOOST_NESTED_TEMPLATE process_variant_alternative< StateT, IndexV, variant_type >;
+            }
+            template< typename StateT >
+            void init_entry(mpl::true_ const&)
+            {
+                m_pRows[StateT::state_id][IndexV] =
+                    &state_machine_type::BOOST_NESTED_TEMPLATE process_unexpected_variant_alternative< IndexV, variant_type >;
+            }
+        };
+
+        //! Recursive initialization of the table for the variant alternatives
+        template< std::size_t IndexV, std::size_t EndV >
+        struct alternatives_iteration
+        {
+            static void init(process_fun_t (*pRows)[alternatives_count])
+            {
+                initializer< IndexV > init(pRows);
+                states_compound_type::for_each_state(init);
+                alternatives_iteration< IndexV + 1, EndV >::init(pRows);
+            }
+        };
+        template< std::size_t EndV >
+        struct alternatives_iteration< EndV, EndV >
+        {
+            static void init(process_fun_t (*)[alternatives_count]) {}
+        };
+
+    private:
+        //! The table of processing functions
+        process_fun_t m_Rows[state_machine_type::states_count][alternatives_count];
+
+        //! The only dispatcher instance
+        static variant_dispatcher const g_Instance;
+
+    public:
+        //! Default constructor
+        BOOST_FSM_NOINLINE variant_dispatcher()
+        {
+            alternatives_iteration< 0, alternatives_count >::init(m_Rows);
+        }
+
+        //! The method returns the function to process the variant alternative in the state
+        BOOST_FSM_FORCEINLINE process_fun_t operator() (state_id_t state_id, std::size_t index) const
+        {
+            return m_Rows[state_id][index];
+        }
+
+        //! The method returns a reference to the only dispatcher instance
+        static BOOST_FSM_FORCEINLINE variant_dispatcher const& get()
+        {
+            return g_Instance;
+        }
+    };
+
+    //! Implementation of the variant dispatchers
+    template< typename VariantT, typename StateMachineT >
+    variant_dispatcher< VariantT, StateMachineT > const variant_dispatcher< VariantT, StateMachineT >::g_Instance;
+
+#endif // defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+
+
+    /*!
+    *    \brief A class used to dispatch events passed by a reference to their base class
+    *
+    *    The dispatcher resolves the dynamic type of the event to its index in the EventListT sequence
+    *    with a binary search in the sorted table of the events type information. The table is built once
+    *    and is read-only afterwards, so, unlike a cache filled on lookups, it needs no synchronization
+    *    and has no misses for events whose type was not seen before. The table of functions,
+    *    indexed by the state identifier and the event index, is then used to process the event as if
+    *    it was passed with its actual type.
+    */
+    template< typename EventListT, typename EventBaseT, typename StateMachineT >
+    class dynamic_event_dispatcher
+    {
+    private:
+        //! State machine base class
+        typedef StateMachineT state_machine_type;
+        //! State machine return type
+        typedef typename state_machine_type::return_type return_type;
+        //! States compound type
+        typedef typename state_machine_type::states_compound_type states_compound_type;
+        //! Function type used to process the event in a single state
+        typedef return_type (BOOST_FSM_FASTCALL* process_fun_t)(states_compound_type&, EventBaseT const&);
+
+    public:
+        //! Number of events
+        BOOST_STATIC_CONSTANT(std::size_t, events_count = mpl::size< EventListT >::value);
+
+    private:
+        //! An entry of the events type information table
+        struct key
+        {
+            //! Event type information
+            typeindex::type_index Type;
+            //! Event index in EventListT
+            std::size_t Index;
+
+            key() : Index(0) {}
+            bool operator< (key const& that) const { return (Type < that.Type); }
+            bool operator< (typeindex::type_index const& that) const { return (Type < that); }
+        };
+
+        //! A visitor that fills the table column for the event
+        template< typename EventT >
+        struct initializer
+        {
+            process_fun_t (*m_pRows)[events_count];
+            std::size_t m_EventIndex;
+
+            initializer(process_fun_t (*pRows)[events_count], std::size_t EventIndex) : m_pRows(pRows), m_EventIndex(EventIndex) {}
+
+            template< typename StateT >
+            void visit()
+            {
+                init_entry< StateT >(typename is_event_unexpected< state_machine_type, StateT, EventT >::type());
+            }
+
+            template< typename StateT >
+            void init_entry(mpl::false_ const&)
+            {
+                m_pRows[StateT::state_id][m_EventIndex] =
+                    &state_machine_type::BOOST_NESTED_TEMPLATE process_dynamic_event< StateT, EventT, EventBaseT >;
+            }
+            template< typename StateT >
+            void init_entry(mpl::true_ const&)
+            {
+                m_pRows[StateT::state_id][m_EventIndex] =
+                    &state_machine_type::BOOST_NESTED_TEMPLATE process_unexpected_dynamic_event< EventT, EventBaseT >;
+            }
+        };
+
+        //! Recursive initialization of the tables for the events in the list
+        template< typename IteratorT, typename EndT >
+        struct events_iteration
+        {
+            typedef typename mpl::deref< IteratorT >::type event_type;
+            BOOST_STATIC_ASSERT((is_base_and_derived< EventBaseT, event_type >::value));
+
+            static void init(process_fun_t (*pRows)[events_count], key* pKeys, std::size_t EventIndex)
+            {
+                initializer< event_type > init(pRows, EventIndex);
+                states_compound_type::for_each_state(init);
+                pKeys[EventIndex].Type = typeindex::type_id< event_type >();
+                pKeys[EventIndex].Index = EventIndex;
+                events_iteration< typename mpl::next< IteratorT >::type, EndT >::init(pRows, pKeys, EventIndex + 1);
+            }
+        };
+        template< typename EndT >
+        struct events_iteration< EndT, EndT >
+        {
+            static void init(process_fun_t (*)[events_count], key*, std::size_t) {}
+        };
+
+    private:
+        //! The table of processing functions
+        process_fun_t m_Rows[state_machine_type::states_count][events_count];
+        //! The events type information, sorted
+        key m_Keys[events_count];
+
+        //! The only dispatcher instance
+        static dynamic_event_dispatcher const g_Instance;
+
+    public:
+        //! Default constructor
+        BOOST_FSM_NOINLINE dynamic_event_dispatcher()
+        {
+            events_iteration<
+                typename mpl::begin< EventListT >::type,
+                typename mpl::end< EventListT >::type
+            >::init(m_Rows, m_Keys, 0);
+            std::sort(m_Keys, m_Keys + events_count);
+        }
+
+        //! The method returns the index of the event type in EventListT or events_count if the type is not in the list
+        std::size_t find(typeindex::type_index const& type) const
+        {
+            key const* const pEnd = m_Keys + events_count;
+            key const* const p = std::lower_bound(m_Keys, pEnd, type);
+            if (p != pEnd && p->Type == type)
+                return p->Index;
+            else
+                return events_count;
+        }
+
+        //! The method returns the function to process the event with the specified index in the state
+        BOOST_FSM_FORCEINLINE process_fun_t operator() (state_id_t state_id, std::size_t index) const
+        {
+            return m_Rows[state_id][index];
+        }
+
+        //! The method returns a reference to the only dispatcher instance
+        static BOOST_FSM_FORCEINLINE dynamic_event_dispatcher const& get()
+        {
+            return g_Instance;
+        }
+    };
+
+    //! Implementation of the dynamic event dispatchers
+    template< typename EventListT, typename EventBaseT, typename StateMachineT >
+    dynamic_event_dispatcher< EventListT, EventBaseT, StateMachineT > const
+    dynamic_event_dispatcher< EventListT, EventBaseT, StateMachineT >::g_Instance;
+
+
+    /*!
+    *    \brief A class used to dispatch integral constant-tagged events with the tag known in run time
+    *
+    *    The dispatcher holds a single table of functions, indexed by the event tag in range [BeginTagV, EndTagV)
+    *    and the state identifier. Each function constructs the event_c with the tag from the event arguments,
+    *    which are moved into the event if possible, and processes it in the state. EventT is the event_c type
+    *    with the tag BeginTagV.
+    */
+    template< int BeginTagV, int EndTagV, typename EventT, typename StateMachineT >
+    class tagged_event_dispatcher
+    {
+        BOOST_STATIC_ASSERT(BeginTagV < EndTagV);
+
+    private:
+        //! State machine base class
+        typedef StateMachineT state_machine_type;
+        //! State machine return type
+        typedef typename state_machine_type::return_type return_type;
+        //! States compound type
+        typedef typename state_machine_type::states_compound_type states_compound_type;
+        //! The event arguments type
+        typedef typename EventT::arguments_type arguments_type;
+        //! Function type used to process the event in a single state
+        typedef return_type (BOOST_FSM_FASTCALL* process_fun_t)(states_compound_type&, arguments_type&);
+
+    public:
+        //! Number of tags
+        BOOST_STATIC_CONSTANT(std::size_t, tags_count = EndTagV - BeginTagV);
+
+    private:
+        //! A visitor that fills the table row for the tag
+        template< int TagV >
+        struct initializer
+        {
+            typedef typename rebind_event_c< EventT, TagV >::type event_type;
+
+            process_fun_t* m_pRow;
+
+            explicit initializer(process_fun_t* pRow) : m_pRow(pRow) {}
+
+            template< typename StateT >
+            void visit()
+            {
+                init_entry< StateT >(typename is_event_unexpected< state_machine_type, StateT, event_type >::type());
+            }
+
+            template< typename StateT >
+            void init_entry(mpl::false_ const&)
+            {
+                m_pRow[StateT::state_id] =
+                    &state_machine_type::BOOST_NESTED_TEMPLATE process_tagged_event< StateT, event_type >;
+            }
+            template< typename StateT >
+            void init_entry(mpl::true_ const&)
+            {
+                m_pRow[StateT::state_id] =
+                    &state_machine_type::BOOST_NESTED_TEMPLATE process_unexpected_tagged_event< event_type >;
+            }
+        };
+
+        //! Recursive initialization of the table for the tags in range
+        template< int TagV, int EndV >
+        struct tags_iteration
+        {
+            static void init(process_fun_t (*pRows)[state_machine_type::states_count])
+            {
+                initializer< TagV > init(*pRows);
+                states_compound_type::for_each_state(init);
+                tags_iteration< TagV + 1, EndV >::init(pRows + 1);
+            }
+        };
+        template< int EndV >
+        struct tags_iteration< EndV, EndV >
+        {
+            static void init(process_fun_t (*)[state_machine_type::states_count]) {}
+        };
+
+    private:
+        //! The table of processing functions
+        process_fun_t m_Rows[tags_count][state_machine_type::states_count];
+
+        //! The only dispatcher instance
+        static tagged_event_dispatcher const g_Instance;
+
+    public:
+        //! Default constructor
+        BOOST_FSM_NOINLINE tagged_event_dispatcher()
+        {
+            tags_iteration< BeginTagV, EndTagV >::init(m_Rows);
+        }
+
+        //! The method checks if the tag is in the range of the table
+        static BOOST_FSM_FORCEINLINE bool is_valid(int tag)
+        {
+            return (tag >= BeginTagV && tag < EndTagV);
+        }
+
+        //! The method returns the function to process the event with the tag in the state
+        BOOST_FSM_FORCEINLINE process_fun_t operator() (int tag, state_id_t state_id) const
+        {
+            BOOST_ASSERT(tag >= BeginTagV && tag < EndTagV);
+            return m_Rows[tag - BeginTagV][state_id];
+        }
+
+        //! The method returns a reference to the only dispatcher instance
+        static BOOST_FSM_FORCEINLINE tagged_event_dispatcher const& get()
+        {
+            return g_Instance;
+        }
+    };
+
+    //! Implementation of the tagged event dispatchers
+    template< int BeginTagV, int EndTagV, typename EventT, typename StateMachineT >
+    tagged_event_dispatcher< BeginTagV, EndTagV, EventT, StateMachineT > const
+    tagged_event_dispatcher< BeginTagV, EndTagV, EventT, StateMachineT >::g_Instance;
+
+
+    /*!
+    *    \brief A class that holds a bit mask of states that accept an event
+    *
+    *    A state accepts an event if it either has an appropriate on_process handler or
+    *    there is a transition rule for the state and the event in the transitions map.
+    *    If ByTargetV is true, the event must also be expected in the transition target state, if the target is known at compile time.
+    */
+    template< typename EventT, typename StateMachineT, bool ByTargetV >
+    class event_acceptor
+    {
+    private:
+        //! State machine base class
+        typedef StateMachineT state_machine_type;
+        //! The event type
+        typedef EventT event_type;
+        //! States compound type
+        typedef typename state_machine_type::states_compound_type states_compound_type;
+        //! Bit mask word type
+        typedef unsigned int word_type;
+
+        //! Bit mask size constants
+        enum
+        {
+            word_bits = sizeof(word_type) * CHAR_BIT,
+            words_count = (state_machine_type::states_count + word_bits - 1) / word_bits
+        };
+
+        //! A visitor that sets bits for the states that accept the event
+        struct initializer
+        {
+            word_type* m_pBits;
+
+            explicit initializer(word_type* pBits) : m_pBits(pBits) {}
+
+            template< typename StateT >
+            void visit()
+            {
+                typedef typename mpl::if_c<
+                    ByTargetV,
+                    is_event_accepted_by_target< state_machine_type, StateT, event_type >,
+                    is_event_accepted< StateT, event_type, typename state_machine_type::transitions_type_list >
+                >::type is_accepted_t;
+                if (is_accepted_t::type::value)
+                    m_pBits[StateT::state_id / word_bits] |= word_type(1) << (StateT::state_id % word_bits);
+            }
+        };
+
+    private:
+        //! The bit mask of the states that accept the event
+        word_type m_Bits[words_count];
+
+        //! The only acceptor instance
+        static event_acceptor const g_Instance;
+
+    public:
+        //! Default constructor
+        BOOST_FSM_NOINLINE event_acceptor()
+        {
+            // The same reasoning as for state_dispatcher applies to the race condition here
+            for (unsigned int i = 0; i < words_count; ++i)
+                m_Bits[i] = 0;
+            initializer init(m_Bits);
+            states_compound_type::for_each_state(init);
+        }
+
+        //! The method checks if the state accepts the event
+        BOOST_FSM_FORCEINLINE bool operator[] (state_id_t state_id) const
+        {
+            return ((m_Bits[state_id / word_bits] >> (state_id % word_bits)) & 1) != 0;
+        }
+
+        //! The method returns a reference to the only acceptor instance
+        static BOOST_FSM_FORCEINLINE event_acceptor const& get()
         {
             return g_Instance;
         }
     };
 
-    //! Implementation of the state dispatchers
-    template< typename EventT, typename StateMachineT >
-    state_dispatcher< EventT, StateMachineT > const state_dispatcher< EventT, StateMachineT >::g_Instance;
+    //! Implementation of the event acceptors
+    template< typename EventT, typename StateMachineT, bool ByTargetV >
+    event_acceptor< EventT, StateMachineT, ByTargetV > const event_acceptor< EventT, StateMachineT, ByTargetV >::g_Instance;
+
+
+    //! A class that holds sets of accepted events for every state. The events are identified by their indices in the events list.
+    template< typename EventListT, typename StateMachineT >
+    class accepted_events_table
+    {
+    public:
+        //! The set of accepted events type
+        typedef std::bitset< mpl::size< EventListT >::value > events_set;
+
+    private:
+        //! State machine base class
+        typedef StateMachineT state_machine_type;
+        //! States compound type
+        typedef typename state_machine_type::states_compound_type states_compound_type;
+
+        //! A visitor that marks the event as accepted in the states that accept it
+        template< typename EventT >
+        struct initializer
+        {
+            events_set* m_pRows;
+            std::size_t m_EventIndex;
+
+            initializer(events_set* pRows, std::size_t EventIndex) : m_pRows(pRows), m_EventIndex(EventIndex) {}
+
+            template< typename StateT >
+            void visit()
+            {
+                if (is_event_accepted< StateT, EventT, typename state_machine_type::transitions_type_list >::value)
+                    m_pRows[StateT::state_id].set(m_EventIndex);
+            }
+        };
+
+        //! Recursive initialization of the table for the events in the list
+        template< typename IteratorT, typename EndT >
+        struct events_iteration
+        {
+            static void init(events_set* pRows, std::size_t EventIndex)
+            {
+                initializer< typename mpl::deref< IteratorT >::type > init(pRows, EventIndex);
+                states_compound_type::for_each_state(init);
+                events_iteration< typename mpl::next< IteratorT >::type, EndT >::init(pRows, EventIndex + 1);
+            }
+        };
+        template< typename EndT >
+        struct events_iteration< EndT, EndT >
+        {
+            static void init(events_set*, std::size_t) {}
+        };
+
+    private:
+        //! Sets of accepted events for every state
+        events_set m_Rows[state_machine_type::states_count];
+
+        //! The only table instance
+        static accepted_events_table const g_Instance;
+
+    public:
+        //! Default constructor
+        BOOST_FSM_NOINLINE accepted_events_table()
+        {
+            events_iteration<
+                typename mpl::begin< EventListT >::type,
+                typename mpl::end< EventListT >::type
+            >::init(m_Rows, 0);
+        }
+
+        //! The subscript operator returns the set of events accepted in the state
+        BOOST_FSM_FORCEINLINE events_set const& operator[] (state_id_t state_id) const
+        {
+            return m_Rows[state_id];
+        }
+
+        //! The method returns a reference to the only table instance
+        static BOOST_FSM_FORCEINLINE accepted_events_table const& get()
+        {
+            return g_Instance;
+        }
+    };
+
+    //! Implementation of the accepted events tables
+    template< typename EventListT, typename StateMachineT >
+    accepted_events_table< EventListT, StateMachineT > const accepted_events_table< EventListT, StateMachineT >::g_Instance;
 
 
     //! An implementation of state machine
-    template< typename StateListT, typename RetValT, typename TransitionListT >
+    template< typename StateListT, typename RetValT, typename TransitionListT, typename UnexpectedHandlerT >
     class basic_state_machine
     {
     private:
@@ -694,6 +1716,19 @@ namespace aux {
         //! A class used to dispatch a call to process method depending on the current state (declaring as a friend)
         template< typename, typename >
         friend class state_dispatcher;
+        //! Classes that determine events acceptance in states (declaring as friends)
+        template< typename, typename, bool >
+        friend class event_acceptor;
+        template< typename, typename >
+        friend class accepted_events_table;
+#if defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+        template< typename, typename >
+        friend class variant_dispatcher;
+#endif // defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+        template< typename, typename, typename >
+        friend class dynamic_event_dispatcher;
+        template< int, int, typename, typename >
+        friend class tagged_event_dispatcher;
 
         //! Self type
         typedef basic_state_machine this_type;
@@ -703,7 +1738,7 @@ namespace aux {
     public:
 #endif // defined(__GNUC__)
         //! A type that inherits all states
-        typedef states_compound< StateListT, RetValT > states_compound_type;
+        typedef states_compound< StateListT, RetValT, UnexpectedHandlerT > states_compound_type;
 
     public:
         //! States type sequence
@@ -716,10 +1751,19 @@ namespace aux {
             mpl::vector0< >,
             TransitionListT
         >::type transitions_type_list;
+        //! Unexpected events handler policy. If void, the handler is set in run time with set_unexpected_event_handler.
+        typedef UnexpectedHandlerT unexpected_handler_type;
 
         //! States count
         BOOST_STATIC_CONSTANT(unsigned int, states_count = mpl::size< states_type_list >::value);
 
+        //! The metafunction checks if the state accepts the event, in the sense of the can_process method
+        template< typename StateT, typename EventT >
+        struct accepts_event :
+            public is_event_accepted< StateT, EventT, transitions_type_list >
+        {
+        };
+
     protected:
         //! State machine root type (protected only to allow library extensions access the type)
         typedef state_machine_root< states_count, return_type > root_type;
@@ -750,6 +1794,7 @@ namespace aux {
                 // Race condition is possible here, but it is not significant
                 // since only POD types are involved and the result of initialization
                 // does not depend on number of threads or number of initializations.
+                // Default state names are constructed with call_once protection.
                 if (!m_fInitialized)
                 {
                     // Fill m_StatesInfo array for all states
@@ -771,7 +1816,7 @@ namespace aux {
     public:
         /*!
         *    \brief Default constructor
-        *    \throw Nothing unless a state constructor throws
+        *    \throw Nothing unless a state constructor or get_state_name throws
         */
         basic_state_machine()
         {
@@ -785,7 +1830,7 @@ namespace aux {
         /*!
         *    \brief A constructor with automatic unexpected events handler setting
         *    \param handler Unexpected event handler, see set_unexpected_event_handler comment.
-        *    \throw Nothing unless a state constructor or set_unexpected_event_handler throws
+        *    \throw Nothing unless a state constructor, get_state_name or set_unexpected_event_handler throws
         */
         template< typename T >
         basic_state_machine(T const& handler)
@@ -813,6 +1858,191 @@ namespace aux {
             typedef state_dispatcher< EventT, this_type > dispatcher_type;
             return (dispatcher_type::get()[get_current_state_id()].first)(m_States, evt);
         }
+        /*!
+        *    \brief Event processing routine (non-throwing version)
+        *
+        *    Unlike process, the method does not invoke unexpected events handler. If the current state
+        *    does not accept the event, in the sense of the can_process method, errc::unexpected_event is returned.
+        *    The same result is returned if the event is accepted by a transition and the transition target state,
+        *    known at compile time, does not accept the event. If the transition decides on the target state in run time,
+        *    the event is processed as with the process method and may be passed to the unexpected events handler.
+        *
+        *    \param evt The event to pass to state machine
+        *    \return The result of on_process handler called or errc::unexpected_event
+        *    \throw May only throw if an on_process handler throws
+        */
+        template< typename EventT >
+        result< return_type > try_process(EventT const& evt)
+        {
+            typedef event_acceptor< EventT, this_type, true > acceptor_type;
+            if (acceptor_type::get()[get_current_state_id()])
+                return try_process_impl(evt, is_same< return_type, void >());
+            else
+                return result< return_type >(errc::unexpected_event);
+        }
+        /*!
+        *    \brief Event processing routine for the case when the current state is likely known
+        *
+        *    If the state machine is in the StateT state, the method resolves the event handler or the transition
+        *    at compile time, without the table dispatch, and the call may be inlined. Otherwise the method is
+        *    equivalent to process. If an automatic transition takes place the event is delivered to
+        *    the target state via the table dispatch.
+        *
+        *    \param evt The event to pass to state machine
+        *    \return The same as process
+        *    \throw The same as process
+        */
+        template< typename StateT, typename EventT >
+        return_type process_in_state(EventT const& evt)
+        {
+            if (is_in_state< StateT >())
+                return process_in_known_state< StateT >(m_States, evt);
+            else
+                return process(evt);
+        }
+
+#if defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+        /*!
+        *    \brief Event processing routine for a variant of events
+        *
+        *    The event held in the variant is processed as if it was passed to process directly.
+        *    The dispatch is performed with a single lookup by the current state and the variant index.
+        *
+        *    \param evt The variant with the event to pass to state machine
+        *    \return The result of on_process handler called or, in case if no handler found, the result of an unexpected event routine
+        *    \throw std::bad_variant_access if the variant is valueless by exception, otherwise the same as process
+        */
+        template< typename... EventsT >
+        return_type process(std::variant< EventsT... > const& evt)
+        {
+            typedef variant_dispatcher< std::variant< EventsT... >, this_type > dispatcher_type;
+            const std::size_t index = evt.index();
+            if (index < sizeof...(EventsT))
+                return (dispatcher_type::get()(get_current_state_id(), index))(m_States, evt);
+            else
+                throw_exception(std::bad_variant_access());
+        }
+#endif // defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+
+        /*!
+        *    \brief Event processing routine for events passed by a reference to their base class
+        *
+        *    The dynamic type of the event is looked up in the EventListT sequence and the event is processed
+        *    as if it was passed to process with that type. If the type is not in the list, the event is passed
+        *    to process with EventBaseT type. The lookup is made with Boost.TypeIndex, so EventBaseT
+        *    should be polymorphic (or, if RTTI is disabled, registered with BOOST_TYPE_INDEX_REGISTER_CLASS).
+        *
+        *    \param evt The event to pass to state machine
+        *    \return The same as process
+        *    \throw The same as process
+        */
+        template< typename EventListT, typename EventBaseT >
+        return_type process_dynamic(EventBaseT const& evt)
+        {
+            typedef dynamic_event_dispatcher< EventListT, EventBaseT, this_type > dispatcher_type;
+            dispatcher_type const& dispatcher = dispatcher_type::get();
+            return process_dynamic_impl(dispatcher, evt, dispatcher.find(typeindex::type_id_runtime(evt)));
+        }
+        /*!
+        *    \brief Event processing routine for events passed by a reference to their base class
+        *
+        *    The method is equivalent to the previous one, except that the event type is identified by the caller.
+        *    This allows to avoid run time type information lookup, if the event base class stores a type tag.
+        *
+        *    \param evt The event to pass to state machine
+        *    \param index The index of the dynamic type of the event in the EventListT sequence.
+        *                 If not less than the size of the sequence, the event is passed to process with EventBaseT type.
+        *                 The index is verified against the run time type information in debug builds, if RTTI is enabled.
+        *    \return The same as process
+        *    \throw The same as process
+        */
+        template< typename EventListT, typename EventBaseT >
+        return_type process_dynamic(EventBaseT const& evt, std::size_t index)
+        {
+            typedef dynamic_event_dispatcher< EventListT, EventBaseT, this_type > dispatcher_type;
+            dispatcher_type const& dispatcher = dispatcher_type::get();
+#if !defined(BOOST_NO_RTTI)
+            // A mismatched index would make the event be cast to a wrong type
+            BOOST_ASSERT(index >= dispatcher_type::events_count || dispatcher.find(typeindex::type_id_runtime(evt)) == index);
+#endif // !defined(BOOST_NO_RTTI)
+            return process_dynamic_impl(dispatcher, evt, index);
+        }
+
+#if defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+        /*!
+        *    \brief Event processing routine for integral constant-tagged events with the tag known in run time
+        *
+        *    The method is equivalent to process(make_event< TagV >(args...)) for tag equal to TagV.
+        *    The dispatch is performed with a single lookup by the tag and the current state
+        *    in a table generated for the tags in range [BeginTagV, EndTagV). If the tag is out of range,
+        *    invalid_event_tag is passed to the unexpected events handler.
+        *
+        *    \param tag The event tag
+        *    \param args The event arguments
+        *    \return The same as process
+        *    \throw The same as process
+        */
+        template< int BeginTagV, int EndTagV, typename... ArgsT >
+        return_type process_c(int tag, ArgsT&&... args)
+        {
+            typedef typename event_c_type_maker< BeginTagV, ArgsT... >::type event_type;
+            typedef tagged_event_dispatcher< BeginTagV, EndTagV, event_type, this_type > dispatcher_type;
+            if (!dispatcher_type::is_valid(tag))
+                return deliver_unexpected_event(m_States, invalid_event_tag(tag));
+            typename event_type::arguments_type Args(event_args_init(), static_cast< ArgsT&& >(args)...);
+            return (dispatcher_type::get()(tag, get_current_state_id()))(m_States, Args);
+        }
+#else // defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+
+#define BOOST_FSM_PROCESS_C(z, iter, data)\
+        template< int BeginTagV, int EndTagV BOOST_PP_ENUM_TRAILING_PARAMS(iter, typename T) >\
+        return_type process_c(int tag BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(iter, T, const& Arg))\
+        {\
+            typedef typename event_c_type_maker< BeginTagV BOOST_PP_ENUM_TRAILING_PARAMS(iter, T) >::type event_type;\
+            typedef tagged_event_dispatcher< BeginTagV, EndTagV, event_type, this_type > dispatcher_type;\
+            if (!dispatcher_type::is_valid(tag))\
+                return deliver_unexpected_event(m_States, invalid_event_tag(tag));\
+            typename event_type::arguments_type Args(make_tuple(BOOST_PP_ENUM_PARAMS(iter, Arg)));\
+            return (dispatcher_type::get()(tag, get_current_state_id()))(m_States, Args);\
+        }
+
+        //! Event processing routine for integral constant-tagged events with the tag known in run time
+        BOOST_PP_REPEAT(BOOST_FSM_MAX_EVENT_ARGS, BOOST_FSM_PROCESS_C, ~)
+
+#undef BOOST_FSM_PROCESS_C
+
+#endif // defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+
+        /*!
+        *    \brief The method checks if the state machine is able to process an event in the current state
+        *    \return true if the current state has an on_process handler for the event or there is a transition
+        *            for the event in the transitions map, false otherwise
+        *    \throw None
+        */
+        template< typename EventT >
+        bool can_process() const
+        {
+            typedef event_acceptor< EventT, this_type, false > acceptor_type;
+            return acceptor_type::get()[get_current_state_id()];
+        }
+
+        /*!
+        *    \brief The method returns the set of events accepted in the specified state
+        *    \param state_id The identifier of the state
+        *    \return The bit set where each bit corresponds to the event in EventListT sequence with the same index.
+        *            The bit is set if the event is accepted in the state, in the sense of the can_process method.
+        *    \throw bad_state_id if the state_id argument is invalid
+        */
+        template< typename EventListT >
+        typename accepted_events_table< EventListT, this_type >::events_set const&
+        accepted_events(state_id_t state_id) const
+        {
+            typedef accepted_events_table< EventListT, this_type > table_type;
+            if (state_id < states_count)
+                return table_type::get()[state_id];
+            else
+                throw_exception(bad_state_id(state_id, get_current_state_name(), get_current_state_type(), get_current_state_id()));
+        }
 
         /*!
         *    \brief The method checks if th state machine is in a specified state
@@ -866,7 +2096,7 @@ namespace aux {
         *    \brief The method returns current state type info
         *    \sa state_machine_root::get_current_state_type
         */
-        std::type_info const& get_current_state_type() const
+        type_info_t const& get_current_state_type() const
         {
             BOOST_FSM_ASSUME(&m_States != NULL);
             root_type const& Root = m_States;
@@ -876,7 +2106,7 @@ namespace aux {
         *    \brief The method returns a state type info
         *    \sa state_machine_root::get_state_type
         */
-        std::type_info const& get_state_type(state_id_t state_id) const
+        type_info_t const& get_state_type(state_id_t state_id) const
         {
             BOOST_FSM_ASSUME(&m_States != NULL);
             root_type const& Root = m_States;
@@ -903,28 +2133,136 @@ namespace aux {
             return Root.get_state_name(state_id);
         }
         /*!
+        *    \brief The method returns a state name (non-throwing version)
+        *    \sa state_machine_root::try_get_state_name
+        */
+        result< std::string const& > try_get_state_name(state_id_t state_id) const
+        {
+            BOOST_FSM_ASSUME(&m_States != NULL);
+            root_type const& Root = m_States;
+            return Root.try_get_state_name(state_id);
+        }
+        /*!
         *    \brief The method sets an unexpected events handler
-        *    \sa state_machine_root::set_unexpected_event_handler
+        *    \sa unexpected_event_handler_storage::set_unexpected_event_handler
         */
         template< typename T >
         void set_unexpected_event_handler(T const& handler)
         {
-            BOOST_FSM_ASSUME(&m_States != NULL);
-            root_type& Root = m_States;
-            Root.set_unexpected_event_handler(handler);
+            m_States.set_unexpected_event_handler(handler);
         }
         /*!
         *    \brief The method resets the unexpected events handler to the default
-        *    \sa state_machine_root::set_default_unexpected_event_handler
+        *    \sa unexpected_event_handler_storage::set_default_unexpected_event_handler
         */
         void set_default_unexpected_event_handler()
         {
-            BOOST_FSM_ASSUME(&m_States != NULL);
-            root_type& Root = m_States;
-            Root.set_default_unexpected_event_handler();
+            m_States.set_default_unexpected_event_handler();
         }
 
     private:
+        //! The method processes the event in the known current state
+        template< typename StateT, typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type process_in_known_state(states_compound_type& States, EventT const& Event)
+        {
+            typedef find_transition< StateT, EventT, transitions_type_list > transition_lookup_t;
+            return process_in_state_impl< StateT, typename transition_lookup_t::type >(
+                States, Event, typename transition_lookup_t::is_not_found());
+        }
+
+#if defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+        //! The method processes the variant alternative in the state
+        template< typename StateT, std::size_t IndexV, typename VariantT >
+        static return_type BOOST_FSM_FASTCALL process_variant_alternative(states_compound_type& States, VariantT const& Event)
+        {
+            return process_in_known_state< StateT >(States, *std::get_if< IndexV >(&Event));
+        }
+        //! The method passes the variant alternative to the unexpected events handler, the function is shared by all states
+        template< std::size_t IndexV, typename VariantT >
+        static return_type BOOST_FSM_FASTCALL process_unexpected_variant_alternative(states_compound_type& States, VariantT const& Event)
+        {
+            return deliver_unexpected_event(States, *std::get_if< IndexV >(&Event));
+        }
+#endif // defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+
+        //! The method processes the event with its actual type in the state
+        template< typename StateT, typename EventT, typename EventBaseT >
+        static return_type BOOST_FSM_FASTCALL process_dynamic_event(states_compound_type& States, EventBaseT const& Event)
+        {
+            return process_in_known_state< StateT >(States, static_cast< EventT const& >(Event));
+        }
+        //! The method passes the event with its actual type to the unexpected events handler, the function is shared by all states
+        template< typename EventT, typename EventBaseT >
+        static return_type BOOST_FSM_FASTCALL process_unexpected_dynamic_event(states_compound_type& States, EventBaseT const& Event)
+        {
+            return deliver_unexpected_event(States, static_cast< EventT const& >(Event));
+        }
+        //! The method constructs the tagged event from its arguments and processes it in the state
+        template< typename StateT, typename EventT >
+        static return_type BOOST_FSM_FASTCALL process_tagged_event(states_compound_type& States, typename EventT::arguments_type& Args)
+        {
+            return process_in_known_state< StateT >(States, EventT(move_event_arguments(Args)));
+        }
+        //! The method passes the tagged event to the unexpected events handler, the function is shared by all states
+        template< typename EventT >
+        static return_type BOOST_FSM_FASTCALL process_unexpected_tagged_event(states_compound_type& States, typename EventT::arguments_type& Args)
+        {
+            return deliver_unexpected_event(States, EventT(move_event_arguments(Args)));
+        }
+        //! The method processes the event with the resolved type index
+        template< typename DispatcherT, typename EventBaseT >
+        BOOST_FSM_FORCEINLINE return_type process_dynamic_impl(DispatcherT const& dispatcher, EventBaseT const& evt, std::size_t index)
+        {
+            if (index < DispatcherT::events_count)
+                return (dispatcher(get_current_state_id(), index))(m_States, evt);
+            else
+                return process(evt);
+        }
+
+        //! The method processes the accepted event and returns a successful result (void return type version)
+        template< typename EventT >
+        BOOST_FSM_FORCEINLINE result< return_type > try_process_impl(EventT const& evt, mpl::true_ const&)
+        {
+            process(evt);
+            return result< return_type >();
+        }
+        //! The method processes the accepted event and returns a successful result (non-void return type version)
+        template< typename EventT >
+        BOOST_FSM_FORCEINLINE result< return_type > try_process_impl(EventT const& evt, mpl::false_ const&)
+        {
+            return result< return_type >(process(evt));
+        }
+
+        //! The method delivers the event to the known current state (no transition version)
+        template< typename StateT, typename TransitionItT, typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type process_in_state_impl(
+            states_compound_type& States, EventT const& Event, mpl::true_ const&)
+        {
+            typedef typename is_event_delivered_to_state< StateT, EventT, states_type_list, return_type >::type is_delivered_t;
+            return deliver_in_state< StateT >(States, Event, is_delivered_t());
+        }
+        //! The method performs the transition from the known current state
+        template< typename StateT, typename TransitionItT, typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type process_in_state_impl(
+            states_compound_type& States, EventT const& Event, mpl::false_ const&)
+        {
+            return perform_transition< StateT, typename mpl::deref< TransitionItT >::type >(States, Event);
+        }
+        //! The method delivers the event to the state handler
+        template< typename StateT, typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type deliver_in_state(
+            states_compound_type& States, EventT const& Event, mpl::true_ const&)
+        {
+            return deliver_event< StateT >(States, Event);
+        }
+        //! The method delivers the event to the unexpected events handler
+        template< typename StateT, typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type deliver_in_state(
+            states_compound_type& States, EventT const& Event, mpl::false_ const&)
+        {
+            return deliver_unexpected_event(States, Event);
+        }
+
         //! The method performs automatic transition, if there is one in the transitions map, and passes the event to the state
         template< typename StateT, typename TransitionT, typename EventT >
         static return_type BOOST_FSM_FASTCALL perform_transition(states_compound_type& States, EventT const& Event)
@@ -937,12 +2275,29 @@ namespace aux {
             // Perform the transition
             TransitionT::transit(CurrentState, Event);
 
+            typedef typename static_transition_target< TransitionT >::type target_state_t;
+            return deliver_after_transition< target_state_t >(States, Event, is_same< target_state_t, void >());
+        }
+
+        //! The method delivers the event to the state after a transition with the target state unknown at compile time
+        template< typename TargetStateT, typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type deliver_after_transition(
+            states_compound_type& States, EventT const& Event, mpl::true_ const&)
+        {
             // Since the transition might have changed the state
             // we have to perform second dispatch to deliver the event to the actual state.
             root_type& Root = States;
             typedef state_dispatcher< EventT, this_type > dispatcher_type;
             return (dispatcher_type::get()[Root.get_current_state_id()].second)(States, Event);
         }
+        //! The method delivers the event to the state after a transition to the state known at compile time
+        template< typename TargetStateT, typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type deliver_after_transition(
+            states_compound_type& States, EventT const& Event, mpl::false_ const&)
+        {
+            typedef typename is_event_delivered_to_state< TargetStateT, EventT, states_type_list, return_type >::type is_delivered_t;
+            return deliver_in_state< TargetStateT >(States, Event, is_delivered_t());
+        }
 
         //! The method delivers the event to the state
         template< typename StateT, typename EventT >
@@ -955,17 +2310,79 @@ namespace aux {
             current_state_t& CurrentState = static_cast< current_state_t& >(States);
 
             // Invoke event handler
+            return invoke_event_handler< StateT >(States, CurrentState, Event, typename is_next_state_returned< StateT, EventT >::type());
+        }
+
+        //! The method invokes the event handler
+        template< typename StateT, typename CurrentStateT, typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type invoke_event_handler(
+            states_compound_type&, CurrentStateT& CurrentState, EventT const& Event, mpl::false_ const&)
+        {
             return CurrentState.on_process(Event);
         }
+        //! The method invokes the event handler that returns the next state and performs the transition
+        template< typename StateT, typename CurrentStateT, typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type invoke_event_handler(
+            states_compound_type& States, CurrentStateT& CurrentState, EventT const& Event, mpl::true_ const&)
+        {
+            //  Static check for that the next state is only returned by handlers of state machines with void return type
+            BOOST_STATIC_ASSERT((is_same< return_type, void >::value));
+            switch_to_next_state< StateT >(States, CurrentState.on_process(Event));
+        }
+        //! The method performs the transition to the state selected by the event handler
+        template< typename StateT, typename NextT >
+        static BOOST_FSM_FORCEINLINE void switch_to_next_state(states_compound_type& States, NextT const& Next)
+        {
+            typedef typename NextT::states_type_list targets_type_list;
+            StateT& CurrentState = static_cast< StateT& >(States);
+            next_state_switch<
+                typename mpl::begin< targets_type_list >::type,
+                typename mpl::end< targets_type_list >::type
+            >::apply(CurrentState, Next.index());
+        }
+
+        /*!
+        *    \brief The method passes the event that is not expected in the current state to the unexpected events handler
+        *
+        *    The current state is taken from the state machine in run time, so a single function
+        *    is instantiated for the event type and it is shared by all states.
+        */
+        template< typename EventT >
+        static return_type BOOST_FSM_FASTCALL deliver_unexpected_event(states_compound_type& States, EventT const& Event)
+        {
+            BOOST_FSM_ASSUME(&States != NULL);
+
+            return invoke_unexpected_event_handler(States, Event, is_same< unexpected_handler_type, void >());
+        }
+
+        //! The method invokes the unexpected events handler set in run time
+        template< typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type invoke_unexpected_event_handler(
+            states_compound_type& States, EventT const& Event, mpl::true_ const&)
+        {
+            root_type const& Root = States;
+            return States.on_unexpected_event(Root, Event, Root.get_current_state_type(), Root.get_current_state_id());
+        }
+
+        //! The method invokes the statically configured unexpected events handler
+        template< typename EventT >
+        static BOOST_FSM_FORCEINLINE return_type invoke_unexpected_event_handler(
+            states_compound_type& States, EventT const& Event, mpl::false_ const&)
+        {
+            root_type const& Root = States;
+            return unexpected_handler_type::BOOST_NESTED_TEMPLATE on_unexpected_event< return_type >(
+                Event, Root.get_current_state_id());
+        }
     };
 
     //! Implementation of states information holder
-    template< typename StateListT, typename RetValT, typename TransitionListT >
+    template< typename StateListT, typename RetValT, typename TransitionListT, typename UnexpectedHandlerT >
     typename basic_state_machine<
         StateListT,
         RetValT,
-        TransitionListT
-    >::states_info_holder basic_state_machine< StateListT, RetValT, TransitionListT >::g_StatesInfoHolder;
+        TransitionListT,
+        UnexpectedHandlerT
+    >::states_info_holder basic_state_machine< StateListT, RetValT, TransitionListT, UnexpectedHandlerT >::g_StatesInfoHolder;
 
 #if !defined(BOOST_NO_INCLASS_MEMBER_INITIALIZATION)
 
@@ -977,8 +2394,8 @@ namespace aux {
     const unsigned int basic_state< StateT, StateListT, RetValT >::states_count;
     template< typename StateT, typename StateListT, typename RetValT >
     const state_id_t basic_state< StateT, StateListT, RetValT >::state_id;
-    template< typename StateListT, typename RetValT, typename TransitionListT >
-    const unsigned int basic_state_machine< StateListT, RetValT, TransitionListT >::states_count;
+    template< typename StateListT, typename RetValT, typename TransitionListT, typename UnexpectedHandlerT >
+    const unsigned int basic_state_machine< StateListT, RetValT, TransitionListT, UnexpectedHandlerT >::states_count;
 
 #endif // !defined(BOOST_NO_INCLASS_MEMBER_INITIALIZATION)
 
@@ -992,12 +2409,12 @@ class state :
 };
 
 //! A state machine class for users
-template< typename StateListT, typename RetValT = void, typename TransitionListT = void >
+template< typename StateListT, typename RetValT = void, typename TransitionListT = void, typename UnexpectedHandlerT = void >
 class state_machine :
-    public aux::basic_state_machine< StateListT, RetValT, TransitionListT >
+    public aux::basic_state_machine< StateListT, RetValT, TransitionListT, UnexpectedHandlerT >
 {
     //! Implementation type
-    typedef aux::basic_state_machine< StateListT, RetValT, TransitionListT > base_type;
+    typedef aux::basic_state_machine< StateListT, RetValT, TransitionListT, UnexpectedHandlerT > base_type;
 
 public:
     //! Default constructor
@@ -1009,6 +2426,66 @@ public:
     state_machine(T const& handler) : base_type(handler) {}
 };
 
+/*!
+*    \brief An unexpected events handler policy that ignores unexpected events
+*
+*    The state machine returns a default-constructed value of its return type on unexpected events.
+*/
+struct ignore_unexpected_events
+{
+    template< typename RetValT, typename EventT >
+    static BOOST_FSM_FORCEINLINE RetValT on_unexpected_event(EventT const&, state_id_t)
+    {
+        return RetValT();
+    }
+};
+
+/*!
+*    \brief Unexpected events handler policy with a single handler shared by all state machines that use the policy
+*
+*    The handler is set in run time, like with set_unexpected_event_handler, but it is stored
+*    once per TagT rather than in every state machine instance. The handler has the following signature:
+*
+*    RetValT (any const&, state_id_t);
+*
+*    The handler must be set before the first unexpected event is processed, otherwise
+*    boost::bad_function_call is thrown. Setting the handler is not thread-safe.
+*/
+template< typename TagT, typename RetValT = void >
+struct shared_unexpected_event_handler
+{
+    //! Handler function type
+    typedef function2< RetValT, any const&, state_id_t > handler_type;
+
+    //! The method sets the shared unexpected events handler
+    template< typename T >
+    static void set_handler(T const& handler)
+    {
+        g_Handler = handler;
+    }
+    //! The method removes the shared unexpected events handler
+    static void reset_handler()
+    {
+        g_Handler.clear();
+    }
+
+    //! The method invokes the shared handler
+    template< typename ResultT, typename EventT >
+    static ResultT on_unexpected_event(EventT const& evt, state_id_t state_id)
+    {
+        BOOST_STATIC_ASSERT((is_same< ResultT, RetValT >::value));
+        return g_Handler(any(evt), state_id);
+    }
+
+private:
+    //! The shared handler
+    static handler_type g_Handler;
+};
+
+template< typename TagT, typename RetValT >
+typename shared_unexpected_event_handler< TagT, RetValT >::handler_type
+shared_unexpected_event_handler< TagT, RetValT >::g_Handler;
+
 } // namespace fsm
 
 } // namespace boost
@@ -0,0 +1,808 @@
+/*!
+ * (C) 2026 Andrey Semashev
+ *
+ * Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \file   table_state_machine.hpp
+ * \author Andrey Semashev
+ * \date   18.10.2026
+ *
+ * \brief  This header is the Boost.FSM library implementation, see the library documentation
+ *         at http://www.boost.org/libs/state_machine/doc/state_machine.html. In this file
+ *         the state machine driven by a dense table of next states is implemented.
+ */
+
+#if (defined(_MSC_VER) && _MSC_VER > 1020)
+#pragma once
+#endif // _MSC_VER > 1020
+
+#ifndef BOOST_FSM_TABLE_STATE_MACHINE_HPP_INCLUDED_
+#define BOOST_FSM_TABLE_STATE_MACHINE_HPP_INCLUDED_
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/int.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/max.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/mpl/end.hpp>
+#include <boost/mpl/next.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/fold.hpp>
+#include <boost/mpl/begin.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/eval_if.hpp>
+#include <boost/mpl/has_xxx.hpp>
+#include <boost/mpl/find_if.hpp>
+#include <boost/mpl/index_of.hpp>
+#include <boost/mpl/contains.hpp>
+#include <boost/mpl/placeholders.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/fsm/state_machine.hpp>
+#include <boost/fsm/event.hpp>
+
+namespace boost {
+
+namespace fsm {
+
+/*!
+*    \brief The transitions map wrapper that enables the states minimization
+*
+*    If the transitions map of a table_state_machine is wrapped into this template, equivalent states are merged
+*    into a single row of the transition table. Two states are equivalent if they have equal outputs and for every event
+*    the transitions have equal action identifiers and lead to equivalent states. The minimization is performed
+*    during the static initialization, so only the number of rows in use is reduced; the table storage and the state
+*    index width are still determined by the number of states.
+*/
+template< typename TransitionListT >
+struct minimized
+{
+    //! Transitions map
+    typedef TransitionListT transitions_type_list;
+};
+
+/*!
+*    \brief The transitions map wrapper that supplies a prebuilt transition table
+*
+*    The table is copied as is instead of being evaluated from the transition rules at compile time. TableT must have
+*    the states_count, events_count and max_action_id integral constants and the next_states and actions static arrays
+*    with a row for every state and a column for every event, in the order of the states and events lists. The action
+*    identifiers are 0 for the cells without an action. Such tables are generated by the fsm_compiler tool.
+*/
+template< typename TableT >
+struct prebuilt_table
+{
+    //! Prebuilt table type
+    typedef TableT table_type;
+};
+
+/*!
+*    \brief An event that represents a range of byte values
+*
+*    The event may be used with the process_bytes method of table_state_machine to map all bytes
+*    in the range [FirstV, LastV] to a single event.
+*/
+template< unsigned char FirstV, unsigned char LastV = FirstV >
+struct byte_range
+{
+    BOOST_STATIC_ASSERT(FirstV <= LastV);
+};
+
+namespace aux {
+
+    //! The metafunction selects the smallest unsigned integer type that is able to hold values in range [0, CountV)
+    template< std::size_t CountV >
+    struct table_index_type :
+        public mpl::if_c< (CountV <= 256u), uint8_t, uint16_t >
+    {
+        BOOST_STATIC_ASSERT(CountV <= 65536u);
+    };
+
+    BOOST_MPL_HAS_XXX_TRAIT_NAMED_DEF(has_action_id, action_id, false)
+
+    //! The metafunction extracts the action identifier of the transition rule
+    template< typename TransitionT >
+    struct get_action_id
+    {
+        typedef mpl::int_< TransitionT::action_id::value > type;
+    };
+
+    //! The metafunction returns the action identifier of the transition rule or 0 if the rule has no action
+    template< typename TransitionT >
+    struct transition_action_id :
+        public mpl::eval_if< has_action_id< TransitionT >, get_action_id< TransitionT >, mpl::int_< 0 > >::type
+    {
+    };
+
+    //! The metafunction unwraps the transitions map and detects if the states minimization is requested
+    template< typename TransitionListT >
+    struct table_transitions
+    {
+        typedef TransitionListT type;
+        typedef mpl::false_ is_minimized;
+    };
+    template< typename TransitionListT >
+    struct table_transitions< minimized< TransitionListT > >
+    {
+        typedef TransitionListT type;
+        typedef mpl::true_ is_minimized;
+    };
+
+    BOOST_MPL_HAS_XXX_TRAIT_NAMED_DEF(has_state_output, output, false)
+
+    //! The metafunction extracts the output of the state
+    template< typename StateT >
+    struct get_state_output
+    {
+        typedef mpl::int_< StateT::output::value > type;
+    };
+
+    //! The metafunction returns the output of the state, which distinguishes states in the minimization, 0 if the state has no output
+    template< typename StateT >
+    struct state_output :
+        public mpl::eval_if< has_state_output< StateT >, get_state_output< StateT >, mpl::int_< 0 > >::type
+    {
+    };
+
+    //! The metafunction returns the maximum action identifier of the transition rules
+    template< typename TransitionListT >
+    struct max_transition_action_id :
+        public mpl::fold<
+            TransitionListT,
+            mpl::int_< 0 >,
+            mpl::max< mpl::_1, transition_action_id< mpl::_2 > >
+        >::type
+    {
+    };
+
+    template< typename TableT >
+    struct max_transition_action_id< prebuilt_table< TableT > > :
+        public mpl::int_< TableT::max_action_id >
+    {
+    };
+
+    //! The metafunction detects if the transitions map is a prebuilt table
+    template< typename TransitionListT >
+    struct is_prebuilt_table :
+        public mpl::false_
+    {
+    };
+    template< typename TableT >
+    struct is_prebuilt_table< prebuilt_table< TableT > > :
+        public mpl::true_
+    {
+    };
+
+    /*!
+    *    \brief The metafunction evaluates a single cell of the transition table
+    *
+    *    The first applicable rule in the transitions map selects the next state with its nested target metafunction.
+    *    If there is no applicable rule, the event is ignored and the state is not changed.
+    */
+    template< typename StateListT, typename TransitionListT, typename StateT, typename EventT >
+    struct table_cell
+    {
+        //! An iterator to the applicable transition
+        typedef typename mpl::find_if<
+            TransitionListT,
+            applicable_transition_pred< StateT, EventT >
+        >::type transition_iterator;
+
+        //! MPL-style boolean constant that is true if there is no applicable transition
+        typedef typename is_same<
+            transition_iterator,
+            typename mpl::end< TransitionListT >::type
+        >::type is_not_found;
+
+        //! The applicable transition rule
+        template< typename IteratorT >
+        struct applicable_transition
+        {
+            typedef typename mpl::deref< IteratorT >::type transition_type;
+            typedef typename transition_type::BOOST_NESTED_TEMPLATE target< StateT, EventT >::type next_state_type;
+            BOOST_STATIC_ASSERT((mpl::contains< StateListT, next_state_type >::value));
+
+            typedef typename mpl::index_of< StateListT, next_state_type >::type next_state_index;
+            typedef transition_action_id< transition_type > action_id;
+        };
+        //! The cell that leaves the current state
+        struct no_transition
+        {
+            typedef typename mpl::index_of< StateListT, StateT >::type next_state_index;
+            typedef mpl::int_< 0 > action_id;
+        };
+
+        typedef typename mpl::if_<
+            is_not_found,
+            no_transition,
+            applicable_transition< transition_iterator >
+        >::type cell_type;
+
+        BOOST_STATIC_CONSTANT(unsigned int, next_state_index = cell_type::next_state_index::value);
+        BOOST_STATIC_CONSTANT(unsigned int, action_id = cell_type::action_id::value);
+    };
+
+    /*!
+    *    \brief The states minimization of the transition table
+    *
+    *    The partition of the states is refined until it is stable. On every step the states are sorted by their signatures,
+    *    which consist of the current class of the state, its output, and the classes of the next states and the action
+    *    identifiers for every event. The states with equal signatures make a class of the next partition.
+    */
+    template< typename StateIndexT, typename ActionIdT >
+    struct table_minimizer
+    {
+        //! The ordering predicate of the states signatures
+        struct signature_order
+        {
+            StateIndexT const* m_pNextStates;
+            ActionIdT const* m_pActions;
+            unsigned int const* m_pOutputs;
+            unsigned int const* m_pClasses;
+            unsigned int m_EventsCount;
+
+            //! The method compares signatures of two states, returns a negative value, zero or a positive value
+            int compare(unsigned int left, unsigned int right) const
+            {
+                if (m_pClasses[left] != m_pClasses[right])
+                    return (m_pClasses[left] < m_pClasses[right]) ? -1 : 1;
+                if (m_pOutputs[left] != m_pOutputs[right])
+                    return (m_pOutputs[left] < m_pOutputs[right]) ? -1 : 1;
+
+                StateIndexT const* pLeft = m_pNextStates + left * m_EventsCount;
+                StateIndexT const* pRight = m_pNextStates + right * m_EventsCount;
+                for (unsigned int i = 0; i < m_EventsCount; ++i)
+                {
+                    const unsigned int left_class = m_pClasses[pLeft[i]], right_class = m_pClasses[pRight[i]];
+                    if (left_class != right_class)
+                        return (left_class < right_class) ? -1 : 1;
+                }
+
+                if (m_pActions)
+                {
+                    ActionIdT const* pLeftActions = m_pActions + left * m_EventsCount;
+                    ActionIdT const* pRightActions = m_pActions + right * m_EventsCount;
+                    for (unsigned int i = 0; i < m_EventsCount; ++i)
+                    {
+                        if (pLeftActions[i] != pRightActions[i])
+                            return (pLeftActions[i] < pRightActions[i]) ? -1 : 1;
+                    }
+                }
+
+                return 0;
+            }
+
+            bool operator() (unsigned int left, unsigned int right) const
+            {
+                return (compare(left, right) < 0);
+            }
+        };
+
+        /*!
+        *    \brief The function merges equivalent states of the table
+        *
+        *    The rows of the classes are written to the beginning of the table, the class of the initial state is 0.
+        *    The classes of the original states and the original states that represent the classes are returned
+        *    in the pClasses and pStateIds arrays. The actions table may be NULL.
+        *
+        *    \return The number of classes
+        */
+        static unsigned int apply(
+            StateIndexT* pNextStates,
+            ActionIdT* pActions,
+            unsigned int const* pOutputs,
+            unsigned int states_count,
+            unsigned int events_count,
+            StateIndexT* pClasses,
+            StateIndexT* pStateIds)
+        {
+            std::vector< unsigned int > classes(states_count, 0u), new_classes(states_count), order(states_count);
+            for (unsigned int i = 0; i < states_count; ++i)
+                order[i] = i;
+
+            unsigned int classes_count = 1;
+            while (true)
+            {
+                signature_order ord = { pNextStates, pActions, pOutputs, &classes[0], events_count };
+                std::sort(order.begin(), order.end(), ord);
+
+                unsigned int new_classes_count = 0;
+                new_classes[order[0]] = 0;
+                for (unsigned int i = 1; i < states_count; ++i)
+                {
+                    if (ord.compare(order[i - 1], order[i]) != 0)
+                        ++new_classes_count;
+                    new_classes[order[i]] = new_classes_count;
+                }
+                ++new_classes_count;
+
+                classes.swap(new_classes);
+                if (new_classes_count == classes_count)
+                    break;
+                classes_count = new_classes_count;
+            }
+
+            // Number the classes in the order of their first states, so that the class of the initial state is 0
+            std::vector< unsigned int > numbers(classes_count, classes_count);
+            unsigned int next_number = 0;
+            for (unsigned int i = 0; i < states_count; ++i)
+            {
+                unsigned int& number = numbers[classes[i]];
+                if (number == classes_count)
+                {
+                    number = next_number++;
+                    pStateIds[number] = static_cast< StateIndexT >(i);
+                }
+                pClasses[i] = static_cast< StateIndexT >(number);
+            }
+
+            // The state that represents a class is never before the class row, so the rows may be moved in place
+            for (unsigned int c = 0; c < classes_count; ++c)
+            {
+                const unsigned int state = pStateIds[c];
+                for (unsigned int i = 0; i < events_count; ++i)
+                {
+                    pNextStates[c * events_count + i] = pClasses[pNextStates[state * events_count + i]];
+                    if (pActions)
+                        pActions[c * events_count + i] = pActions[state * events_count + i];
+                }
+            }
+
+            return classes_count;
+        }
+    };
+
+    /*!
+    *    \brief The table of the next states of a table state machine
+    *
+    *    The table is indexed by the current state index and the event index. The cells are evaluated
+    *    at compile time from the transitions map, the table only stores the results. If the minimization is enabled,
+    *    the table rows are indexed by the classes of equivalent states rather than the states.
+    */
+    template< typename StateListT, typename EventListT, typename TransitionListT, bool IsMinimizedV >
+    class transition_table
+    {
+    public:
+        //! Number of states
+        BOOST_STATIC_CONSTANT(unsigned int, states_count = mpl::size< StateListT >::value);
+        //! Number of events
+        BOOST_STATIC_CONSTANT(unsigned int, events_count = mpl::size< EventListT >::value);
+        //! Maximum action identifier
+        BOOST_STATIC_CONSTANT(unsigned int, max_action_id = max_transition_action_id< TransitionListT >::value);
+        //! The flag is true if any transition rule has an action identifier
+        BOOST_STATIC_CONSTANT(bool, has_actions = (max_action_id > 0));
+        //! The flag is true if the equivalent states are merged
+        BOOST_STATIC_CONSTANT(bool, is_minimized = IsMinimizedV);
+
+        //! State index type
+        typedef typename table_index_type< states_count >::type state_index_type;
+        //! Action identifier type
+        typedef typename table_index_type< max_action_id + 1 >::type action_id_type;
+
+    private:
+        //! Recursive initialization of the table row for the events in the list
+        template< typename StateT, typename IteratorT, typename EndT >
+        struct events_iteration
+        {
+            static void init(state_index_type* pNextStates, action_id_type* pActions)
+            {
+                typedef table_cell< StateListT, TransitionListT, StateT, typename mpl::deref< IteratorT >::type > cell_t;
+                *pNextStates = static_cast< state_index_type >(cell_t::next_state_index);
+                if (has_actions)
+                    *pActions = static_cast< action_id_type >(cell_t::action_id);
+                events_iteration< StateT, typename mpl::next< IteratorT >::type, EndT >::init(
+                    pNextStates + 1, has_actions ? pActions + 1 : pActions);
+            }
+        };
+        template< typename StateT, typename EndT >
+        struct events_iteration< StateT, EndT, EndT >
+        {
+            static void init(state_index_type*, action_id_type*) {}
+        };
+
+        //! Recursive initialization of the table rows for the states in the list
+        template< typename IteratorT, typename EndT >
+        struct states_iteration
+        {
+            static void init(
+                state_index_type (*pNextStates)[events_count],
+                action_id_type (*pActions)[has_actions ? events_count : 1],
+                unsigned int* pOutputs)
+            {
+                typedef typename mpl::deref< IteratorT >::type state_type;
+                if (is_minimized)
+                    *pOutputs = state_output< state_type >::value;
+                events_iteration<
+                    typename mpl::deref< IteratorT >::type,
+                    typename mpl::begin< EventListT >::type,
+                    typename mpl::end< EventListT >::type
+                >::init(*pNextStates, *pActions);
+                states_iteration< typename mpl::next< IteratorT >::type, EndT >::init(
+                    pNextStates + 1, has_actions ? pActions + 1 : pActions, is_minimized ? pOutputs + 1 : pOutputs);
+            }
+        };
+        template< typename EndT >
+        struct states_iteration< EndT, EndT >
+        {
+            static void init(state_index_type (*)[events_count], action_id_type (*)[has_actions ? events_count : 1], unsigned int*) {}
+        };
+
+        //! Recursive evaluation of the outputs of the states in the list
+        template< typename IteratorT, typename EndT >
+        struct outputs_iteration
+        {
+            static void init(unsigned int* pOutputs)
+            {
+                *pOutputs = state_output< typename mpl::deref< IteratorT >::type >::value;
+                outputs_iteration< typename mpl::next< IteratorT >::type, EndT >::init(pOutputs + 1);
+            }
+        };
+        template< typename EndT >
+        struct outputs_iteration< EndT, EndT >
+        {
+            static void init(unsigned int*) {}
+        };
+
+    private:
+        //! The next states
+        state_index_type m_NextStates[states_count][events_count];
+        //! The action identifiers, the array is only used if any transition has an action
+        action_id_type m_Actions[has_actions ? states_count : 1][has_actions ? events_count : 1];
+        //! The classes of the states, the array is only used if the minimization is enabled
+        state_index_type m_Classes[is_minimized ? states_count : 1];
+        //! The states that represent the classes, the array is only used if the minimization is enabled
+        state_index_type m_StateIds[is_minimized ? states_count : 1];
+        //! The number of classes
+        unsigned int m_ClassesCount;
+
+        //! The only table instance
+        static transition_table const g_Instance;
+
+    public:
+        //! Default constructor
+        BOOST_FSM_NOINLINE transition_table()
+        {
+            m_Actions[0][0] = 0;
+            m_Classes[0] = m_StateIds[0] = 0;
+            m_ClassesCount = states_count;
+
+            std::vector< unsigned int > outputs(is_minimized ? states_count : 1u);
+            init_rows(&outputs[0], typename is_prebuilt_table< TransitionListT >::type());
+
+            if (is_minimized)
+            {
+                m_ClassesCount = table_minimizer< state_index_type, action_id_type >::apply(
+                    &m_NextStates[0][0],
+                    has_actions ? &m_Actions[0][0] : static_cast< action_id_type* >(0),
+                    &outputs[0],
+                    states_count,
+                    events_count,
+                    m_Classes,
+                    m_StateIds);
+            }
+        }
+
+    private:
+        //! The method evaluates the table rows from the transition rules
+        void init_rows(unsigned int* pOutputs, mpl::false_ const&)
+        {
+            states_iteration<
+                typename mpl::begin< StateListT >::type,
+                typename mpl::end< StateListT >::type
+            >::init(m_NextStates, m_Actions, pOutputs);
+        }
+        //! The method copies the table rows from the prebuilt table
+        void init_rows(unsigned int* pOutputs, mpl::true_ const&)
+        {
+            typedef typename TransitionListT::table_type prebuilt_table_type;
+            BOOST_STATIC_ASSERT(prebuilt_table_type::states_count == states_count);
+            BOOST_STATIC_ASSERT(prebuilt_table_type::events_count == events_count);
+
+            for (unsigned int s = 0; s < states_count; ++s)
+            {
+                for (unsigned int e = 0; e < events_count; ++e)
+                {
+                    BOOST_ASSERT(prebuilt_table_type::next_states[s][e] < states_count);
+                    m_NextStates[s][e] = static_cast< state_index_type >(prebuilt_table_type::next_states[s][e]);
+                    if (has_actions)
+                        m_Actions[s][e] = static_cast< action_id_type >(prebuilt_table_type::actions[s][e]);
+                }
+            }
+
+            if (is_minimized)
+            {
+                outputs_iteration<
+                    typename mpl::begin< StateListT >::type,
+                    typename mpl::end< StateListT >::type
+                >::init(pOutputs);
+            }
+        }
+
+    public:
+        //! The method returns the index of the next state
+        BOOST_FSM_FORCEINLINE state_index_type next_state(state_index_type state, std::size_t event_index) const
+        {
+            return m_NextStates[state][event_index];
+        }
+        //! The method returns the action identifier of the transition, 0 if there is no action
+        BOOST_FSM_FORCEINLINE unsigned int action(state_index_type state, std::size_t event_index) const
+        {
+            return has_actions ? m_Actions[state][event_index] : 0u;
+        }
+
+        //! The method returns the table row index of the state
+        BOOST_FSM_FORCEINLINE state_index_type state_class(state_id_t state_id) const
+        {
+            return is_minimized ? m_Classes[state_id] : static_cast< state_index_type >(state_id);
+        }
+        //! The method returns the state that corresponds to the table row
+        BOOST_FSM_FORCEINLINE state_id_t state_id(state_index_type state) const
+        {
+            return is_minimized ? m_StateIds[state] : state;
+        }
+        //! The method returns the number of the table rows
+        BOOST_FSM_FORCEINLINE unsigned int classes_count() const
+        {
+            return m_ClassesCount;
+        }
+
+        //! The method returns a reference to the only table instance
+        static BOOST_FSM_FORCEINLINE transition_table const& get()
+        {
+            return g_Instance;
+        }
+    };
+
+    //! Implementation of the transition tables
+    template< typename StateListT, typename EventListT, typename TransitionListT, bool IsMinimizedV >
+    transition_table< StateListT, EventListT, TransitionListT, IsMinimizedV > const
+    transition_table< StateListT, EventListT, TransitionListT, IsMinimizedV >::g_Instance;
+
+    //! The metafunction returns the range of bytes mapped to the event, the range is empty if the event is not mapped to bytes
+    template< typename EventT >
+    struct event_bytes
+    {
+        BOOST_STATIC_CONSTANT(unsigned int, first = 1u);
+        BOOST_STATIC_CONSTANT(unsigned int, last = 0u);
+    };
+    //! The integral constant-tagged events are mapped to the byte equal to the tag
+#if defined(BOOST_FSM_HAS_VARIADIC_EVENTS)
+    template< int TagV, typename... T >
+    struct event_bytes< event_c< TagV, T... > >
+#else
+    template< int TagV, BOOST_PP_ENUM_PARAMS(BOOST_FSM_MAX_EVENT_ARGS, typename T) >
+    struct event_bytes< event_c< TagV, BOOST_PP_ENUM_PARAMS(BOOST_FSM_MAX_EVENT_ARGS, T) > >
+#endif
+    {
+        BOOST_STATIC_CONSTANT(unsigned int, first = ((TagV >= 0 && TagV <= 255) ? TagV : 1u));
+        BOOST_STATIC_CONSTANT(unsigned int, last = ((TagV >= 0 && TagV <= 255) ? TagV : 0u));
+    };
+    template< unsigned char FirstV, unsigned char LastV >
+    struct event_bytes< byte_range< FirstV, LastV > >
+    {
+        BOOST_STATIC_CONSTANT(unsigned int, first = FirstV);
+        BOOST_STATIC_CONSTANT(unsigned int, last = LastV);
+    };
+
+    /*!
+    *    \brief The table that maps byte values to the event indices
+    *
+    *    If several events are mapped to the same byte, the first one in the list is used.
+    *    The bytes that are not mapped to any event are mapped to the number of events.
+    */
+    template< typename EventListT >
+    class byte_events_table
+    {
+    public:
+        //! Number of events
+        BOOST_STATIC_CONSTANT(unsigned int, events_count = mpl::size< EventListT >::value);
+        //! Event index type
+        typedef typename table_index_type< events_count + 1 >::type event_index_type;
+
+    private:
+        //! Recursive initialization of the table for the events in the list
+        template< typename IteratorT, typename EndT >
+        struct events_iteration
+        {
+            static void init(event_index_type* pEvents, unsigned int event_index)
+            {
+                typedef event_bytes< typename mpl::deref< IteratorT >::type > bytes_t;
+                for (unsigned int i = bytes_t::first; i <= bytes_t::last; ++i)
+                {
+                    if (pEvents[i] == events_count)
+                        pEvents[i] = static_cast< event_index_type >(event_index);
+                }
+                events_iteration< typename mpl::next< IteratorT >::type, EndT >::init(pEvents, event_index + 1);
+            }
+        };
+        template< typename EndT >
+        struct events_iteration< EndT, EndT >
+        {
+            static void init(event_index_type*, unsigned int) {}
+        };
+
+    private:
+        //! The event indices
+        event_index_type m_Events[256];
+
+        //! The only table instance
+        static byte_events_table const g_Instance;
+
+    public:
+        //! Default constructor
+        BOOST_FSM_NOINLINE byte_events_table()
+        {
+            std::fill_n(m_Events, 256u, static_cast< event_index_type >(events_count));
+            events_iteration<
+                typename mpl::begin< EventListT >::type,
+                typename mpl::end< EventListT >::type
+            >::init(m_Events, 0);
+        }
+
+        //! The subscript operator returns the index of the event mapped to the byte
+        BOOST_FSM_FORCEINLINE unsigned int operator[] (unsigned char byte) const
+        {
+            return m_Events[byte];
+        }
+
+        //! The method returns a reference to the only table instance
+        static BOOST_FSM_FORCEINLINE byte_events_table const& get()
+        {
+            return g_Instance;
+        }
+    };
+
+    //! Implementation of the byte tables
+    template< typename EventListT >
+    byte_events_table< EventListT > const byte_events_table< EventListT >::g_Instance;
+
+} // namespace aux
+
+/*!
+*    \brief A state machine that is completely described by its transitions map
+*
+*    The states of the machine carry no data and have no event handlers, any types may be used as states.
+*    The transitions map is evaluated at compile time into a dense table of next states, indexed
+*    by the current state and the event, so processing an event is a single table lookup. The rules must
+*    provide the nested target metafunction that returns the next state (transition and basic_transition
+*    do that) and may have the nested action_id integral constant to mark the table cell with an action identifier.
+*    The machine only stores the current state index, so it takes one byte if there are up to 256 states
+*    and is trivially copyable. If the transitions map is wrapped into the minimized template, equivalent states
+*    are merged and the machine stores the index of the class of the current state. The transitions map may also
+*    be replaced with a prebuilt_table, which is not evaluated at compile time.
+*/
+template< typename StateListT, typename EventListT, typename TransitionListT >
+class table_state_machine
+{
+public:
+    //! States type sequence
+    typedef StateListT states_type_list;
+    //! Events type sequence
+    typedef EventListT events_type_list;
+    //! Transitions map
+    typedef typename aux::table_transitions< TransitionListT >::type transitions_type_list;
+    //! Transition table type
+    typedef aux::transition_table<
+        StateListT,
+        EventListT,
+        transitions_type_list,
+        aux::table_transitions< TransitionListT >::is_minimized::value
+    > table_type;
+    //! State index type
+    typedef typename table_type::state_index_type state_index_type;
+
+    //! Number of states
+    BOOST_STATIC_CONSTANT(unsigned int, states_count = table_type::states_count);
+    //! Number of events
+    BOOST_STATIC_CONSTANT(unsigned int, events_count = table_type::events_count);
+
+private:
+    //! The current state index
+    state_index_type m_State;
+
+public:
+    //! Default constructor, the first state in the list is the initial state
+    table_state_machine() : m_State(0) {}
+
+    /*!
+    *    \brief The method passes the event to the machine
+    *    \return The action identifier of the transition, 0 if the transition has no action or no rule applies
+    */
+    template< typename EventT >
+    BOOST_FSM_FORCEINLINE unsigned int process(EventT const&)
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< EventListT, EventT >::value));
+        return process_index(mpl::index_of< EventListT, EventT >::type::value);
+    }
+    /*!
+    *    \brief The method passes the event with the specified index in the events list to the machine
+    *    \return The action identifier of the transition, 0 if the transition has no action or no rule applies
+    */
+    BOOST_FSM_FORCEINLINE unsigned int process_index(std::size_t event_index)
+    {
+        BOOST_ASSERT(event_index < events_count);
+        table_type const& table = table_type::get();
+        const unsigned int action = table.action(m_State, event_index);
+        m_State = table.next_state(m_State, event_index);
+        return action;
+    }
+
+    /*!
+    *    \brief The method passes the bytes in the buffer to the machine as events
+    *
+    *    Every byte is mapped to the first event in the events list that represents the byte value, which is either
+    *    event_c with the tag equal to the byte value or byte_range that contains it. The bytes that are not mapped
+    *    to any event are ignored. The processing stops after a transition with a non-zero action identifier.
+    *
+    *    \param p The pointer to the bytes
+    *    \param n The number of bytes
+    *    \param action Receives the action identifier of the transition that stopped the processing, 0 if all bytes were processed
+    *    \return The number of processed bytes, including the byte that stopped the processing
+    */
+    std::size_t process_bytes(const char* p, std::size_t n, unsigned int& action)
+    {
+        typedef aux::byte_events_table< EventListT > byte_events_table_type;
+        table_type const& table = table_type::get();
+        byte_events_table_type const& bytes = byte_events_table_type::get();
+
+        const unsigned char* const pBegin = reinterpret_cast< const unsigned char* >(p);
+        const unsigned char* const pEnd = pBegin + n;
+        const unsigned char* pByte = pBegin;
+        state_index_type state = m_State;
+        action = 0;
+        while (pByte != pEnd)
+        {
+            const unsigned int event_index = bytes[*pByte++];
+            if (event_index < events_count)
+            {
+                action = table.action(state, event_index);
+                state = table.next_state(state, event_index);
+                if (table_type::has_actions && action != 0)
+                    break;
+            }
+        }
+        m_State = state;
+
+        return static_cast< std::size_t >(pByte - pBegin);
+    }
+    //! \overload
+    std::size_t process_bytes(const char* p, std::size_t n)
+    {
+        unsigned int action;
+        return process_bytes(p, n, action);
+    }
+
+    //! The method resets the machine to the initial state
+    void reset() { m_State = 0; }
+
+    /*!
+    *    \brief The method returns the current state identifier, which is the index of the state in the states list
+    *
+    *    If the states are minimized, the identifier of the first state of the class of equivalent states is returned.
+    */
+    state_id_t get_current_state_id() const { return table_type::get().state_id(m_State); }
+
+    //! The method checks if the machine is in the specified state or a state that is equivalent to it
+    template< typename StateT >
+    bool is_in_state() const
+    {
+        BOOST_STATIC_ASSERT((mpl::contains< StateListT, StateT >::value));
+        return (m_State == table_type::get().state_class(mpl::index_of< StateListT, StateT >::type::value));
+    }
+
+    //! The method returns the number of states after the minimization
+    static unsigned int get_minimized_states_count() { return table_type::get().classes_count(); }
+};
+
+} // namespace fsm
+
+} // namespace boost
+
+#endif // BOOST_FSM_TABLE_STATE_MACHINE_HPP_INCLUDED_
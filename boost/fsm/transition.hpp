@@ -35,6 +35,13 @@ struct any_state;
 template< typename NextStateT >
 struct basic_transition
 {
+    //! The metafunction returns the state the transition switches to
+    template< typename CurrentStateT, typename EventT >
+    struct target
+    {
+        typedef NextStateT type;
+    };
+
     //! The function actually performs the transition
     template< typename CurrentStateT, typename EventT >
     static BOOST_FSM_FORCEINLINE void transit(CurrentStateT& state, EventT const&)
@@ -79,6 +86,28 @@ struct transition< any_state, EventT, NextStateT > : public basic_transition< Ne
     };
 };
 
+namespace aux {
+
+    /*!
+    *    \brief The metafunction returns the target state of the transition rule if it is known at compile time
+    *
+    *    The result is void for the rules that may decide on the transition in run time.
+    *    The state machine uses the target state to deliver the event after the transition without the second dispatch.
+    */
+    template< typename TransitionT >
+    struct static_transition_target
+    {
+        typedef void type;
+    };
+
+    template< typename CurrentStateT, typename EventT, typename NextStateT >
+    struct static_transition_target< transition< CurrentStateT, EventT, NextStateT > >
+    {
+        typedef NextStateT type;
+    };
+
+} // namespace aux
+
 } // namespace fsm
 
 } // namespace boost
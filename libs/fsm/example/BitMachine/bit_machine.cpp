@@ -38,7 +38,6 @@
 #include <boost/mpl/range_c.hpp>
 #include <boost/mpl/for_each.hpp>
 #include <boost/preprocessor/repetition/enum.hpp>
-#include <boost/preprocessor/repetition/repeat.hpp>
 #include <boost/fsm/state_machine.hpp>
 #include <boost/fsm/event.hpp>
 #include <boost/fsm/transition.hpp>
@@ -198,9 +197,6 @@ inline void print_current_state_name(BitFSM_t const& fsm)
     std::cout << "The current state is: " << fsm.get_current_state_name() << std::endl;
 }
 
-// The type of trampolines
-typedef void (*trampoline_t)(BitFSM_t& fsm);
-
 //! A function object to pass an event to the state machine
 struct invoke_sm
 {
@@ -221,14 +217,6 @@ public:
     {
         m_fsm.process(boost::fsm::make_event< BitNoT::value >());
     }
-
-    //! The trampoline function to pass an event to the machine
-    template< int BitNoV >
-    static void trampoline(BitFSM_t& fsm)
-    {
-        invoke_sm invoker(fsm);
-        invoker(boost::mpl::int_< BitNoV >());
-    }
 };
 
 //! Performance test implementation
@@ -272,14 +260,6 @@ void run_performance_test(BitFSM_t& fsm)
 //////////////////////////////////////////////////////////////////////////
 int main()
 {
-    // The array of trampolines to pass different events to the machine in run time
-    trampoline_t trampolines[NO_OF_BITS];
-
-    // Initialize trampolines
-#define MAKE_TRAMPOLINE(z, iter, data) trampolines[iter] = &invoke_sm::trampoline< iter >;
-    BOOST_PP_REPEAT(NO_OF_BITS, MAKE_TRAMPOLINE, ~)
-#undef MAKE_TRAMPOLINE
-
     // Print usage
     std::cout << "Boost.FSM BitMachine example\n";
     std::cout << "Machine configuration: " << (unsigned int)(NO_OF_STATES)
@@ -316,7 +296,8 @@ int main()
     {
         if ((key >= '0') && (key < static_cast< char >('0' + NO_OF_BITS)))
         {
-            trampolines[key - '0'](fsm);
+            // The event tag is only known in run time
+            fsm.process_c< 0, NO_OF_BITS >(key - '0');
         }
         else
         {
@@ -326,7 +307,7 @@ int main()
             {
                 for (unsigned int i = 0; i < NO_OF_BITS; ++i)
                 {
-                    trampolines[i](fsm);
+                    fsm.process_c< 0, NO_OF_BITS >(i);
                 }
             }
             break;
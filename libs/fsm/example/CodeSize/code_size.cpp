@@ -0,0 +1,208 @@
+/*!
+* (C) 2026 Andrey Semashev
+*
+* Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+* (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*
+* \file   code_size.cpp
+* \author Andrey Semashev
+* \date   18.10.2026
+*
+* \brief  A sample code to track the size of the code generated for a state machine
+*
+* The generated FSM is a ring of states, each state handles a single event type and switches to the next state.
+* All other events are unexpected, so the dispatching tables mostly consist of the unexpected events entries.
+* Build the "code_size_report" target to get the section sizes of the executable.
+* You may configure the test with these macros:
+* - NO_OF_STATES. The number of states.
+* - NO_OF_EVENTS. The number of event types.
+* - USE_TRANSITION_MAPS. If defined, the states switch with a transition map instead of event handlers.
+* - USE_RUNTIME_HANDLER. If defined, the unexpected events handler is set in run time instead of
+*   being statically configured to ignore the unexpected events.
+*/
+
+#include <iostream>
+#include <boost/config.hpp>
+#include <boost/any.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/long.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/mpl/advance.hpp>
+#include <boost/mpl/distance.hpp>
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/for_each.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/fsm/state_machine.hpp>
+#include <boost/fsm/event.hpp>
+#include <boost/fsm/transition.hpp>
+
+#ifndef NO_OF_STATES
+#define NO_OF_STATES 16
+#endif // NO_OF_STATES
+
+#ifndef NO_OF_EVENTS
+#define NO_OF_EVENTS 16
+#endif // NO_OF_EVENTS
+
+//////////////////////////////////////////////////////////////////////////
+//  Ring state machine implementation
+//////////////////////////////////////////////////////////////////////////
+
+//! State class forward
+template< unsigned int >
+struct RingState;
+
+//! A structure to generate states list
+struct StatesList
+{
+    struct tag {};
+
+    template< unsigned int N >
+    struct iterator
+    {
+        typedef RingState< N > type;
+        typedef iterator< N + 1 > next;
+    };
+    typedef iterator< 0 > begin;
+    typedef iterator< NO_OF_STATES > end;
+};
+
+//  Additional MPL specializations to make StatesList operations more efficient
+namespace boost { namespace mpl {
+
+template< unsigned int N1, unsigned int N2 >
+struct distance< StatesList::iterator< N1 >, StatesList::iterator< N2 > >
+{
+    typedef long_< N2 - N1 > type;
+    enum { value = type::value };
+};
+
+template< unsigned int N, long ShiftV >
+struct advance_c< StatesList::iterator< N >, ShiftV >
+{
+    typedef StatesList::iterator< N + ShiftV > type;
+};
+template< unsigned int N, typename ShiftT >
+struct advance< StatesList::iterator< N >, ShiftT >
+{
+    typedef StatesList::iterator< N + ShiftT::value > type;
+};
+
+} } // namespace boost::mpl
+
+//! State implementation
+template< unsigned int ValueV >
+struct RingState :
+    public boost::fsm::state< RingState< ValueV >, StatesList >
+{
+    //! The next state in the ring
+    typedef RingState< (ValueV + 1) % NO_OF_STATES > next_state_type;
+    //! The event type handled by the state
+    typedef boost::fsm::event_c< ValueV % NO_OF_EVENTS > event_type;
+
+#ifndef USE_TRANSITION_MAPS
+    //! The handler of the only expected event
+    void on_process(event_type const&)
+    {
+        this->BOOST_NESTED_TEMPLATE switch_to< next_state_type >();
+    }
+#endif // USE_TRANSITION_MAPS
+};
+
+#ifdef USE_TRANSITION_MAPS
+
+//! Transition implementation
+struct RingTransition
+{
+    template< typename StateT, typename EventT >
+    struct is_applicable :
+        public boost::is_same< typename StateT::event_type, EventT >
+    {
+    };
+
+    template< typename StateT, typename EventT >
+    static void transit(StateT& state, EventT const&)
+    {
+        state.BOOST_NESTED_TEMPLATE switch_to< typename StateT::next_state_type >();
+    }
+};
+
+//! Transitions list
+typedef boost::mpl::vector< RingTransition >::type TransitionsList_t;
+
+#else // USE_TRANSITION_MAPS
+
+typedef void TransitionsList_t;
+
+#endif // USE_TRANSITION_MAPS
+
+#ifdef USE_RUNTIME_HANDLER
+typedef void UnexpectedHandler_t;
+#else
+typedef boost::fsm::ignore_unexpected_events UnexpectedHandler_t;
+#endif // USE_RUNTIME_HANDLER
+
+//! State machine type
+typedef boost::fsm::state_machine< StatesList, void, TransitionsList_t, UnexpectedHandler_t > RingFSM_t;
+
+
+//////////////////////////////////////////////////////////////////////////
+//  Test implementation
+//////////////////////////////////////////////////////////////////////////
+
+//! A function object to pass an event to the state machine
+struct invoke_sm
+{
+    //! Return type
+    typedef void result_type;
+
+private:
+    //! A bound reference to the machine
+    RingFSM_t& m_fsm;
+
+public:
+    //! Constructor
+    invoke_sm(RingFSM_t& fsm) : m_fsm(fsm) {}
+
+    //! An operator that invokes the machine
+    template< typename EventNoT >
+    void operator() (EventNoT const&) const
+    {
+        m_fsm.process(boost::fsm::make_event< EventNoT::value >());
+    }
+};
+
+#ifdef USE_RUNTIME_HANDLER
+//! The unexpected events handler that ignores the events
+void ignore_unexpected_event(boost::any const&, boost::fsm::type_info_t const&, boost::fsm::state_id_t)
+{
+}
+#endif // USE_RUNTIME_HANDLER
+
+//////////////////////////////////////////////////////////////////////////
+//! Main function
+//////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::cout << "Boost.FSM CodeSize example\n";
+    std::cout << "Machine configuration: " << (unsigned int)(NO_OF_STATES) << " states, "
+        << (unsigned int)(NO_OF_EVENTS) << " event types, "
+        << (unsigned int)(NO_OF_STATES * NO_OF_EVENTS) << " dispatching table entries\n" << std::endl;
+
+    RingFSM_t fsm;
+#ifdef USE_RUNTIME_HANDLER
+    fsm.set_unexpected_event_handler(&ignore_unexpected_event);
+#endif // USE_RUNTIME_HANDLER
+
+    // Pass every event to the machine in every state, so that all dispatching tables are used
+    typedef boost::mpl::range_c< int, 0, NO_OF_EVENTS >::type events_loop_t;
+    invoke_sm invoker(fsm);
+    for (unsigned int i = 0; i < NO_OF_STATES; ++i)
+    {
+        boost::mpl::for_each< events_loop_t >(static_cast< invoke_sm const& >(invoker));
+    }
+
+    std::cout << "The current state is: " << fsm.get_current_state_name() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*!
+* (C) 2026 Andrey Semashev
+*
+* Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+* (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*
+* \file   dynamic_machine.cpp
+* \author Andrey Semashev
+* \date   18.10.2026
+*
+* \brief  A benchmark of the state machine loaded in run time against the same machine defined at compile time
+*
+* The turnstile machine is loaded from the turnstile.fsm file, which path may be passed in the command line.
+* The same sequence of events is passed to the dynamic_state_machine and to the equivalent state_machine.
+* You may configure the test with these macros:
+* - NO_OF_PERFORMANCE_EVENTS. The number of events to pass to the machines.
+*/
+
+#include <ctime>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <boost/config.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/fsm/state_machine.hpp>
+#include <boost/fsm/transition.hpp>
+#include <boost/fsm/dynamic_state_machine.hpp>
+
+#ifndef NO_OF_PERFORMANCE_EVENTS
+#define NO_OF_PERFORMANCE_EVENTS 100000000UL
+#endif // NO_OF_PERFORMANCE_EVENTS
+
+//////////////////////////////////////////////////////////////////////////
+//  Static turnstile state machine implementation
+//////////////////////////////////////////////////////////////////////////
+
+//  Event classes
+struct Coin {};
+struct Push {};
+struct Fail {};
+struct Repair {};
+
+//  State classes forward
+struct Locked;
+struct Unlocked;
+struct Broken;
+
+//! States list
+typedef boost::mpl::vector< Locked, Unlocked, Broken >::type StatesList_t;
+
+struct Locked : public boost::fsm::state< Locked, StatesList_t > {};
+struct Unlocked : public boost::fsm::state< Unlocked, StatesList_t > {};
+struct Broken : public boost::fsm::state< Broken, StatesList_t > {};
+
+//! Transitions list, equivalent to the one in turnstile.fsm
+typedef boost::mpl::vector<
+    boost::fsm::transition< Locked, Coin, Unlocked >,
+    boost::fsm::transition< Locked, Fail, Broken >,
+    boost::fsm::transition< Unlocked, Push, Locked >,
+    boost::fsm::transition< Unlocked, Coin, Unlocked >,
+    boost::fsm::transition< Unlocked, Fail, Broken >,
+    boost::fsm::transition< Broken, Repair, Locked >
+>::type TransitionsList_t;
+
+//! The static state machine type
+typedef boost::fsm::state_machine<
+    StatesList_t,
+    void,
+    TransitionsList_t,
+    boost::fsm::ignore_unexpected_events
+> TurnstileFSM_t;
+
+//! The dynamic state machine type
+typedef boost::fsm::dynamic_state_machine< boost::fsm::ignore_unexpected_events > DynamicFSM_t;
+
+//////////////////////////////////////////////////////////////////////////
+//  Test implementation
+//////////////////////////////////////////////////////////////////////////
+
+//! The number of event types
+enum { NO_OF_EVENTS = 4 };
+
+//! The function passes the event with the specified index to the static machine
+inline void process_static(TurnstileFSM_t& fsm, unsigned int event)
+{
+    switch (event)
+    {
+    case 0: fsm.process(Coin()); break;
+    case 1: fsm.process(Push()); break;
+    case 2: fsm.process(Fail()); break;
+    default: fsm.process(Repair()); break;
+    }
+}
+
+//! The function returns the current time in milliseconds
+inline double get_time_msec()
+{
+    return std::clock() * 1000.0 / CLOCKS_PER_SEC;
+}
+
+//! The function prints the test results
+void print_result(const char* name, double duration_msec, unsigned int state)
+{
+    std::cout << name << ": " << std::fixed << std::setprecision(0) << duration_msec << " ms ("
+        << std::setprecision(3) << duration_msec * 1000000.0 / (double)(NO_OF_PERFORMANCE_EVENTS)
+        << " ns per event), final state " << state << std::endl;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//! Main function
+//////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::cout << "Boost.FSM DynamicMachine example\n" << std::endl;
+
+    const char* const pFileName = argc > 1 ? argv[1] : "turnstile.fsm";
+    std::ifstream file(pFileName);
+    if (!file.is_open())
+    {
+        std::cout << "Could not open the machine definition file " << pFileName << std::endl;
+        return 1;
+    }
+
+    boost::shared_ptr< boost::fsm::dynamic_machine_definition > definition(new boost::fsm::dynamic_machine_definition(file));
+    std::cout << "Loaded " << definition->states_count() << " states, " << definition->events_count() << " events and "
+        << definition->transitions_count() << " transitions\n" << std::endl;
+
+    // The events sequence, the event identifiers of the definition match the indices used in process_static
+    std::vector< unsigned int > events(4096);
+    unsigned int seed = 1;
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        events[i] = (seed >> 16) % NO_OF_EVENTS;
+    }
+    const std::size_t mask = events.size() - 1;
+
+    {
+        TurnstileFSM_t fsm;
+        double start_time = get_time_msec();
+        for (unsigned long i = 0; i < NO_OF_PERFORMANCE_EVENTS; ++i)
+            process_static(fsm, events[i & mask]);
+        print_result("state_machine", get_time_msec() - start_time, fsm.get_current_state_id());
+    }
+
+    {
+        DynamicFSM_t fsm(definition);
+        double start_time = get_time_msec();
+        for (unsigned long i = 0; i < NO_OF_PERFORMANCE_EVENTS; ++i)
+            fsm.process(events[i & mask]);
+        print_result("dynamic_state_machine", get_time_msec() - start_time, fsm.get_current_state_id());
+    }
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*!
+* (C) 2026 Andrey Semashev
+*
+* Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+* (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*
+* \file   machine_array.cpp
+* \author Andrey Semashev
+* \date   18.10.2026
+*
+* \brief  A benchmark of many small machines that receive the same event
+*
+* The same machine definition is used to create an array of state_machine objects and a machine_array
+* of table_state_machine. Every tick event is passed to all machines, the time per machine per event is printed.
+* Enable SSSE3 or AVX2 in the compiler options to get the vectorized machine_array processing.
+* You may configure the test with these macros:
+* - NO_OF_MACHINES. The number of machines.
+* - NO_OF_TICKS. The number of events to pass to every machine.
+*/
+
+#include <ctime>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <boost/config.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/fsm/state_machine.hpp>
+#include <boost/fsm/transition.hpp>
+#include <boost/fsm/table_state_machine.hpp>
+#include <boost/fsm/machine_array.hpp>
+
+#ifndef NO_OF_MACHINES
+#define NO_OF_MACHINES 1000000UL
+#endif // NO_OF_MACHINES
+
+#ifndef NO_OF_TICKS
+#define NO_OF_TICKS 100UL
+#endif // NO_OF_TICKS
+
+//////////////////////////////////////////////////////////////////////////
+//  Timer state machine implementation
+//////////////////////////////////////////////////////////////////////////
+
+//! The event that is broadcast to all machines
+struct Tick {};
+//! The event that restarts the timer
+struct Restart {};
+
+//  State classes forward
+struct Idle;
+struct Armed;
+struct Expiring;
+struct Fired;
+
+//! States list
+typedef boost::mpl::vector< Idle, Armed, Expiring, Fired >::type StatesList_t;
+
+struct Idle : public boost::fsm::state< Idle, StatesList_t > {};
+struct Armed : public boost::fsm::state< Armed, StatesList_t > {};
+struct Expiring : public boost::fsm::state< Expiring, StatesList_t > {};
+struct Fired : public boost::fsm::state< Fired, StatesList_t > {};
+
+//! Transitions list
+typedef boost::mpl::vector<
+    boost::fsm::transition< Idle, Tick, Armed >,
+    boost::fsm::transition< Armed, Tick, Expiring >,
+    boost::fsm::transition< Expiring, Tick, Fired >,
+    boost::fsm::transition< boost::fsm::any_state, Restart, Idle >
+>::type TransitionsList_t;
+
+//! The state machine that ignores ticks in the Fired state
+typedef boost::fsm::state_machine<
+    StatesList_t,
+    void,
+    TransitionsList_t,
+    boost::fsm::ignore_unexpected_events
+> TimerFSM_t;
+
+//! The table state machine with the same definition
+typedef boost::fsm::table_state_machine<
+    StatesList_t,
+    boost::mpl::vector< Tick, Restart >::type,
+    TransitionsList_t
+> TimerTable_t;
+
+
+//////////////////////////////////////////////////////////////////////////
+//  Test implementation
+//////////////////////////////////////////////////////////////////////////
+
+//! The function returns the current time in milliseconds
+inline double get_time_msec()
+{
+    return std::clock() * 1000.0 / CLOCKS_PER_SEC;
+}
+
+//! The function prints the test results
+void print_result(const char* name, double duration_msec, std::size_t fired)
+{
+    std::cout << name << ": " << std::fixed << std::setprecision(0) << duration_msec << " ms ("
+        << std::setprecision(3) << duration_msec * 1000000.0 / ((double)(NO_OF_MACHINES) * (double)(NO_OF_TICKS))
+        << " ns per machine per event), " << fired << " machines fired" << std::endl;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//! Main function
+//////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::cout << "Boost.FSM MachineArray example\n";
+    std::cout << "Configuration: " << (unsigned long)(NO_OF_MACHINES) << " machines, "
+        << (unsigned long)(NO_OF_TICKS) << " events per machine\n" << std::endl;
+
+    // A loop of state_machine::process calls
+    {
+        std::vector< TimerFSM_t > machines(NO_OF_MACHINES);
+        double start_time = get_time_msec();
+        for (unsigned long t = 0; t < NO_OF_TICKS; ++t)
+        {
+            if (t % 8 == 0)
+            {
+                for (std::size_t i = 0; i < machines.size(); ++i)
+                    machines[i].process(Restart());
+            }
+            for (std::size_t i = 0; i < machines.size(); ++i)
+                machines[i].process(Tick());
+        }
+        double duration = get_time_msec() - start_time;
+
+        std::size_t fired = 0;
+        for (std::size_t i = 0; i < machines.size(); ++i)
+            fired += machines[i].is_in_state< Fired >();
+        print_result("state_machine loop", duration, fired);
+    }
+
+    // The machine_array of table machines
+    {
+        boost::fsm::machine_array< TimerTable_t > machines(NO_OF_MACHINES);
+        double start_time = get_time_msec();
+        for (unsigned long t = 0; t < NO_OF_TICKS; ++t)
+        {
+            if (t % 8 == 0)
+                machines.process(Restart());
+            machines.process(Tick());
+        }
+        double duration = get_time_msec() - start_time;
+
+        std::size_t fired = 0;
+        for (std::size_t i = 0; i < machines.size(); ++i)
+            fired += machines.is_in_state< Fired >(i);
+        print_result("machine_array", duration, fired);
+    }
+
+    return 0;
+}
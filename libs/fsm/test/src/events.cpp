@@ -9,8 +9,16 @@
 */
 
 #include "stdafx.hpp"
+#include <memory>
+#include <utility>
 #include <boost/ref.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_empty.hpp>
+#include <boost/utility/string_view.hpp>
 #include <boost/fsm/event.hpp>
+#include <boost/fsm/transition.hpp>
+#include <boost/fsm/any_state_machine.hpp>
+#include <boost/fsm/borrowed.hpp>
 #include "boost_testing_helpers.hpp"
 
 namespace EventsTest {
@@ -156,3 +164,489 @@ BOOST_AUTO_TEST_CASE(simplified_events_support)
 	calc.process(fsm::make_event< GetMemory >(boost::ref(result2)));
 	TEST_REQUIRE(result == result2);
 }
+
+BOOST_AUTO_TEST_CASE(tuple_events_compatibility)
+{
+	TEST_ENTER(tuple_events_compatibility);
+
+	typedef fsm::event< struct Named, int, std::string > NamedEvent_t;
+
+	// The events can be constructed from and assigned from tuples
+	NamedEvent_t evt(boost::make_tuple(1, std::string("one")));
+	TEST_REQUIRE(evt.get< 0 >() == 1);
+	TEST_REQUIRE(evt.get< 1 >() == "one");
+	evt = boost::make_tuple(2, std::string("two"));
+	TEST_REQUIRE(evt.get< 0 >() == 2);
+
+	// The arguments can be accessed and modified through the tuple
+	evt.get_tuple().get< 0 >() = 3;
+	TEST_REQUIRE(evt.get< 0 >() == 3);
+	NamedEvent_t const& const_evt = evt;
+	TEST_REQUIRE(boost::get< 1 >(const_evt.get_tuple()) == "two");
+	NamedEvent_t::tuple_type tuple = evt.get_tuple();
+	TEST_REQUIRE(tuple.get< 0 >() == 3);
+
+	fsm::event_c< 5, int > evt_c(boost::make_tuple(7));
+	TEST_REQUIRE(evt_c.get< 0 >() == 7);
+	evt_c = boost::make_tuple(8);
+	TEST_REQUIRE(evt_c.get_tuple().get< 0 >() == 8);
+}
+
+BOOST_AUTO_TEST_CASE(events_acceptance_check)
+{
+	TEST_ENTER(events_acceptance_check);
+
+	StreamCalc_t calc;
+
+	// The check does not trigger the BOOST_FSM_MUST_HANDLE_ALL_EVENTS assertion
+	TEST_REQUIRE((calc.can_process< fsm::event< Add, int > >()));
+	TEST_REQUIRE((!calc.can_process< fsm::event< Add, double > >()));
+
+	calc.process(fsm::make_event< Add >(1000));
+	TEST_REQUIRE(calc.is_in_state< Overflow >());
+	TEST_REQUIRE((!calc.can_process< fsm::event< Add, int > >()));
+	TEST_REQUIRE((calc.can_process< fsm::event_c< Memorize, int > >()));
+}
+
+namespace TaggedEventsTest {
+
+	// The event tags come from a message header in run time
+	enum
+	{
+		Start,
+		Stop,
+		Ping,
+
+		TagsCount
+	};
+
+	struct Idle;
+	struct Running;
+
+	typedef boost::mpl::vector< Idle, Running >::type StatesList_t;
+
+	struct Idle :
+		public fsm::state< Idle, StatesList_t, int >
+	{
+		int on_process(fsm::event_c< Start, int > const& evt)
+		{
+			switch_to< Running >();
+			return evt.get< 0 >();
+		}
+	};
+
+	struct Running :
+		public fsm::state< Running, StatesList_t, int >
+	{
+		int on_process(fsm::event_c< Stop, int > const& evt)
+		{
+			switch_to< Idle >();
+			return -evt.get< 0 >();
+		}
+	};
+
+	typedef fsm::state_machine< StatesList_t, int > StateMachine_t;
+
+	// The handler returns the invalid tag
+	int on_unexpected_event(boost::any const& evt, fsm::type_info_t const&, fsm::state_id_t)
+	{
+		fsm::invalid_event_tag const* p = boost::any_cast< fsm::invalid_event_tag >(&evt);
+		return p ? p->tag : 0;
+	}
+
+} // namespace TaggedEventsTest
+
+BOOST_AUTO_TEST_CASE(runtime_tagged_events_support)
+{
+	TEST_ENTER(runtime_tagged_events_support);
+
+	using namespace TaggedEventsTest;
+
+	StateMachine_t fsm;
+
+	// The event is the same as made with make_event< Start >(5)
+	int tag = Start;
+	TEST_REQUIRE((fsm.process_c< Start, TagsCount >(tag, 5) == 5));
+	TEST_REQUIRE(fsm.is_in_state< Running >());
+
+	// The unexpected events are passed to the unexpected events handler
+	tag = Ping;
+	bool unexpected = false;
+	try
+	{
+		fsm.process_c< Start, TagsCount >(tag, 5);
+	}
+	catch (fsm::unexpected_event&)
+	{
+		unexpected = true;
+	}
+	TEST_REQUIRE(unexpected);
+	TEST_REQUIRE(fsm.is_in_state< Running >());
+
+	tag = Stop;
+	TEST_REQUIRE((fsm.process_c< Start, TagsCount >(tag, 7) == -7));
+	TEST_REQUIRE(fsm.is_in_state< Idle >());
+
+	// The tags out of range are also passed to the unexpected events handler
+	fsm.set_unexpected_event_handler(&TaggedEventsTest::on_unexpected_event);
+	TEST_REQUIRE((fsm.process_c< Start, TagsCount >(TagsCount + 10, 5) == TagsCount + 10));
+	TEST_REQUIRE((fsm.process_c< Start, TagsCount >(-1, 5) == -1));
+	TEST_REQUIRE(fsm.is_in_state< Idle >());
+}
+
+namespace DynamicEventsTest {
+
+	// Events are passed to the state machine by a reference to their base class
+	struct EventBase
+	{
+		// The type tag is the index of the event type in the list of events
+		unsigned int Kind;
+
+		explicit EventBase(unsigned int kind) : Kind(kind) {}
+		virtual ~EventBase() {}
+	};
+	struct Start : public EventBase
+	{
+		Start() : EventBase(0) {}
+	};
+	struct Stop : public EventBase
+	{
+		Stop() : EventBase(1) {}
+	};
+	// This event type is not registered, it will be passed to the state machine as EventBase
+	struct Pause : public EventBase
+	{
+		Pause() : EventBase(2) {}
+	};
+
+	typedef boost::mpl::vector< Start, Stop >::type Events_t;
+
+	// Forward-declaration of state classes
+	struct Stopped;
+	struct Running;
+
+	typedef boost::mpl::vector<
+		Stopped,
+		Running
+	>::type StatesList_t;
+
+	struct Stopped :
+		public fsm::state< Stopped, StatesList_t, int >
+	{
+		int on_process(Start const&)
+		{
+			switch_to< Running >();
+			return 1;
+		}
+		int on_process(EventBase const&)
+		{
+			return 0;
+		}
+	};
+
+	struct Running :
+		public fsm::state< Running, StatesList_t, int >
+	{
+		int on_process(Stop const&)
+		{
+			switch_to< Stopped >();
+			return 2;
+		}
+		int on_process(EventBase const&)
+		{
+			return 0;
+		}
+	};
+
+	typedef fsm::state_machine< StatesList_t, int > StateMachine_t;
+
+} // namespace DynamicEventsTest
+
+BOOST_AUTO_TEST_CASE(dynamic_events_support)
+{
+	TEST_ENTER(dynamic_events_support);
+
+	using namespace DynamicEventsTest;
+
+	StateMachine_t fsm;
+	const Start start;
+	const Stop stop;
+	const Pause pause;
+	EventBase const& start_ref = start;
+	EventBase const& stop_ref = stop;
+	EventBase const& pause_ref = pause;
+
+	// The static type of the event is used by process
+	TEST_REQUIRE(fsm.process(start_ref) == 0);
+	TEST_REQUIRE(fsm.is_in_state< Stopped >());
+
+	// The dynamic type of the event is used by process_dynamic
+	TEST_REQUIRE(fsm.process_dynamic< Events_t >(start_ref) == 1);
+	TEST_REQUIRE(fsm.is_in_state< Running >());
+	TEST_REQUIRE(fsm.process_dynamic< Events_t >(pause_ref) == 0);
+	TEST_REQUIRE(fsm.is_in_state< Running >());
+	TEST_REQUIRE(fsm.process_dynamic< Events_t >(stop_ref) == 2);
+	TEST_REQUIRE(fsm.is_in_state< Stopped >());
+
+	// The event type may also be identified by the caller
+	TEST_REQUIRE(fsm.process_dynamic< Events_t >(start_ref, start_ref.Kind) == 1);
+	TEST_REQUIRE(fsm.process_dynamic< Events_t >(pause_ref, pause_ref.Kind) == 0);
+	TEST_REQUIRE(fsm.process_dynamic< Events_t >(stop_ref, stop_ref.Kind) == 2);
+	TEST_REQUIRE(fsm.is_in_state< Stopped >());
+}
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_SMART_PTR)
+
+namespace MoveOnlyResultTest {
+
+	// The result type cannot be copied or default-constructed
+	struct Response
+	{
+		std::unique_ptr< std::string > body;
+
+		explicit Response(std::string const& str) : body(new std::string(str)) {}
+	};
+
+	// Event classes
+	struct Request {};
+	struct Go {};
+	struct Unknown {};
+
+	// Forward-declaration of state classes
+	struct Idle;
+	struct Busy;
+
+	typedef boost::mpl::vector<
+		Idle,
+		Busy
+	>::type StatesList_t;
+
+	struct Idle :
+		public fsm::state< Idle, StatesList_t, Response >
+	{
+		typedef boost::mpl::vector<
+			fsm::transition< Idle, Go, Busy >
+		>::type transitions_type_list;
+
+		Response on_process(Request const&)
+		{
+			return Response("idle");
+		}
+	};
+
+	struct Busy :
+		public fsm::state< Busy, StatesList_t, Response >
+	{
+		Response on_process(Go const&)
+		{
+			return Response("busy");
+		}
+	};
+
+	typedef fsm::state_machine< StatesList_t, Response > StateMachine_t;
+
+	Response on_unexpected_event(boost::any const&, fsm::type_info_t const&, fsm::state_id_t)
+	{
+		return Response("unexpected");
+	}
+
+} // namespace MoveOnlyResultTest
+
+BOOST_AUTO_TEST_CASE(move_only_results)
+{
+	TEST_ENTER(move_only_results);
+
+	using namespace MoveOnlyResultTest;
+
+	StateMachine_t fsm;
+	fsm.set_unexpected_event_handler(&MoveOnlyResultTest::on_unexpected_event);
+
+	Response resp = fsm.process(Request());
+	TEST_REQUIRE(*resp.body == "idle");
+	resp = fsm.process_in_state< Idle >(Request());
+	TEST_REQUIRE(*resp.body == "idle");
+	resp = fsm.process(Unknown());
+	TEST_REQUIRE(*resp.body == "unexpected");
+
+	fsm::result< Response > res = fsm.try_process(Request());
+	TEST_REQUIRE(res.succeeded());
+	TEST_REQUIRE(*res.value().body == "idle");
+	TEST_REQUIRE(!fsm.try_process(Unknown()));
+
+	resp = fsm.process(Go()); // switches to Busy
+	TEST_REQUIRE(*resp.body == "busy");
+	TEST_REQUIRE(fsm.is_in_state< Busy >());
+
+	fsm::any_state_machine< boost::mpl::vector< Request, Go >::type, Response > any;
+	any.emplace< StateMachine_t >().set_unexpected_event_handler(&MoveOnlyResultTest::on_unexpected_event);
+	resp = any.process(Go());
+	TEST_REQUIRE(*resp.body == "busy");
+	resp = any.process(Go());
+	TEST_REQUIRE(*resp.body == "busy");
+	resp = any.process(Request());
+	TEST_REQUIRE(*resp.body == "unexpected");
+}
+
+#endif // !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_SMART_PTR)
+
+#if defined(BOOST_FSM_HAS_VARIADIC_EVENTS) && !defined(BOOST_NO_CXX11_SMART_PTR)
+
+namespace VariadicEventsTest {
+
+	// The argument type counts its copies
+	struct Payload
+	{
+		static unsigned int copies;
+
+		std::string data;
+
+		explicit Payload(std::string const& str) : data(str) {}
+		Payload(Payload const& that) : data(that.data) { ++copies; }
+		Payload(Payload&& that) : data(std::move(that.data)) {}
+	};
+	unsigned int Payload::copies = 0;
+
+	// Event tags
+	struct Message;
+	struct Attach;
+	enum { Ping };
+
+	struct Receiving;
+
+	typedef boost::mpl::vector< Receiving >::type StatesList_t;
+
+	struct Receiving :
+		public fsm::state< Receiving, StatesList_t, std::size_t >
+	{
+		std::size_t on_process(fsm::event< Message, Payload, int > const& evt)
+		{
+			return evt.get< 0 >().data.size() + evt.get< 1 >();
+		}
+		std::size_t on_process(fsm::event_c< Ping, Payload > const& evt)
+		{
+			return evt.get< 0 >().data.size();
+		}
+		// Move-only arguments are supported
+		std::size_t on_process(fsm::event< Attach, std::unique_ptr< std::string > > const& evt)
+		{
+			return evt.get< 0 >()->size();
+		}
+	};
+
+	typedef fsm::state_machine< StatesList_t, std::size_t > StateMachine_t;
+
+} // namespace VariadicEventsTest
+
+BOOST_AUTO_TEST_CASE(variadic_events_support)
+{
+	TEST_ENTER(variadic_events_support);
+
+	using namespace VariadicEventsTest;
+
+	BOOST_STATIC_ASSERT((fsm::event< Message, Payload, int >::arity == 2));
+
+	StateMachine_t fsm;
+
+	// The rvalue arguments are moved into the event
+	TEST_REQUIRE((fsm.process(fsm::make_event< Message >(Payload("hello"), 10)) == 15u));
+	TEST_REQUIRE(Payload::copies == 0u);
+	TEST_REQUIRE((fsm.process_c< Ping, Ping + 1 >(Ping, Payload("hello")) == 5u));
+	TEST_REQUIRE(Payload::copies == 0u);
+
+	// The lvalue arguments are copied once
+	Payload payload("hi");
+	fsm::event< Message, Payload, int > evt = fsm::make_event< Message >(payload, 1);
+	TEST_REQUIRE(Payload::copies == 1u);
+	TEST_REQUIRE(fsm.process(evt) == 3u);
+	evt.get< 1 >() = 2;
+	TEST_REQUIRE(fsm.process(evt) == 4u);
+	TEST_REQUIRE(Payload::copies == 1u);
+
+	std::unique_ptr< std::string > str(new std::string("attachment"));
+	TEST_REQUIRE(fsm.process(fsm::make_event< Attach >(std::move(str))) == 10u);
+}
+
+#endif // defined(BOOST_FSM_HAS_VARIADIC_EVENTS) && !defined(BOOST_NO_CXX11_SMART_PTR)
+
+namespace BorrowedEventsTest {
+
+	// Event tags
+	struct Packet;
+	struct Unknown;
+
+	typedef fsm::borrowed< boost::string_view > Payload_t;
+	typedef fsm::event< Packet, Payload_t > PacketEvent_t;
+	typedef fsm::event< Unknown, Payload_t > UnknownEvent_t;
+
+	struct Receiving;
+
+	typedef boost::mpl::vector< Receiving >::type StatesList_t;
+
+	struct Receiving :
+		public fsm::state< Receiving, StatesList_t, std::size_t >
+	{
+		std::size_t on_process(PacketEvent_t const& evt)
+		{
+			// The accessor returns the view
+			boost::string_view const& payload = evt.get< 0 >();
+			return payload.size();
+		}
+	};
+
+	typedef fsm::state_machine< StatesList_t, std::size_t > StateMachine_t;
+
+	// The unexpected event is passed by a shallow copy
+	const char* g_UnexpectedData = 0;
+	std::size_t on_unexpected_event(boost::any const& evt, fsm::type_info_t const&, fsm::state_id_t)
+	{
+		g_UnexpectedData = boost::any_cast< UnknownEvent_t const& >(evt).get< 0 >().data();
+		return 0;
+	}
+
+} // namespace BorrowedEventsTest
+
+BOOST_AUTO_TEST_CASE(borrowed_events_support)
+{
+	TEST_ENTER(borrowed_events_support);
+
+	using namespace BorrowedEventsTest;
+
+	StateMachine_t fsm;
+	fsm.set_unexpected_event_handler(&BorrowedEventsTest::on_unexpected_event);
+
+	char buffer[] = "received data";
+	fsm::borrow_scope scope;
+
+	PacketEvent_t evt = fsm::make_event< Packet >(scope.borrow(boost::string_view(buffer, 8)));
+	TEST_REQUIRE(evt.get< 0 >().data() == buffer);
+	TEST_REQUIRE(fsm.process(evt) == 8u);
+
+	fsm.process(fsm::make_event< Unknown >(scope.borrow(boost::string_view(buffer))));
+	TEST_REQUIRE(g_UnexpectedData == buffer);
+
+	// The buffer is about to be reused
+	TEST_REQUIRE(evt.get_tuple().get< 0 >().is_valid());
+	scope.release();
+#if defined(BOOST_FSM_CHECK_BORROWED_LIFETIME)
+	TEST_REQUIRE(!evt.get_tuple().get< 0 >().is_valid());
+#endif // defined(BOOST_FSM_CHECK_BORROWED_LIFETIME)
+
+	// The views borrowed after the release are valid
+	evt = fsm::make_event< Packet >(scope.borrow(boost::string_view(buffer, 4)));
+	TEST_REQUIRE(evt.get_tuple().get< 0 >().is_valid());
+	TEST_REQUIRE(fsm.process(evt) == 4u);
+
+	// The checks may be selected explicitly
+	fsm::basic_borrow_scope< true > checked_scope;
+	fsm::borrowed< boost::string_view, true > checked_view = checked_scope.borrow(boost::string_view(buffer));
+	TEST_REQUIRE(checked_view.is_valid());
+	checked_scope.release();
+	TEST_REQUIRE(!checked_view.is_valid());
+
+	// Without the checks the views are not larger than the view type and the scope is empty
+	BOOST_STATIC_ASSERT(sizeof(fsm::borrowed< boost::string_view, false >) == sizeof(boost::string_view));
+	BOOST_STATIC_ASSERT(boost::is_empty< fsm::basic_borrow_scope< false > >::value);
+
+	// The views not bound to a scope are never checked
+	TEST_REQUIRE(fsm.process(fsm::make_event< Packet >(fsm::borrow(boost::string_view(buffer)))) == 13u);
+}
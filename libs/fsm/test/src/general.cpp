@@ -9,6 +9,9 @@
 */
 
 #include "stdafx.hpp"
+#include <sstream>
+#include <boost/fsm/any_state_machine.hpp>
+#include <boost/fsm/dynamic_state_machine.hpp>
 #include "boost_testing_helpers.hpp"
 
 namespace GeneralTest {
@@ -26,6 +29,13 @@ namespace GeneralTest {
 		{
 		}
 	};
+	struct TrySwitchEvent
+	{
+		fsm::state_id_t state_id;
+		explicit TrySwitchEvent(fsm::state_id_t id) : state_id(id)
+		{
+		}
+	};
 
 	// Forward-declaration of state classes
 	struct InitialState;
@@ -172,12 +182,22 @@ namespace GeneralTest {
 		public fsm::state< FinalState, StatesList_t >,
 		virtual public CommonData
 	{
+		fsm::errc::type m_SwitchStatus;
+
+		// Constructor
+		FinalState() : m_SwitchStatus(fsm::errc::success) {}
+
 		// This handler is just for testing purposes only
 		void on_process(Event3< fsm::state_id_t > const& evt)
 		{
 			trace< Event3< fsm::state_id_t > >();
 			switch_to(evt.value);
 		}
+		// The non-throwing version of the dynamic switch_to
+		void on_process(TrySwitchEvent const& evt)
+		{
+			m_SwitchStatus = try_switch_to(evt.state_id).status();
+		}
 	};
 
 	// Event processing methods
@@ -316,6 +336,81 @@ BOOST_AUTO_TEST_CASE(unexpected_events_handling)
 	fsm.process(Event3< int >(10));
 }
 
+//! This is a statically configured unexpected event handler that counts unexpected events
+struct counting_unexpected_event_handler
+{
+	static unsigned int g_Count;
+	static fsm::state_id_t g_LastStateID;
+
+	template< typename RetValT, typename EventT >
+	static RetValT on_unexpected_event(EventT const&, fsm::state_id_t id)
+	{
+		// The event is passed with its original type, without copying into boost::any
+		if (boost::is_same< EventT, Event3< std::string > >::value)
+			++g_Count;
+		g_LastStateID = id;
+	}
+};
+
+unsigned int counting_unexpected_event_handler::g_Count = 0;
+fsm::state_id_t counting_unexpected_event_handler::g_LastStateID = 0;
+
+BOOST_AUTO_TEST_CASE(static_unexpected_events_handling)
+{
+	TEST_ENTER(static_unexpected_events_handling);
+
+	typedef fsm::state_machine< StatesList_t, void, void, counting_unexpected_event_handler > CountingStateMachine_t;
+	CountingStateMachine_t fsm;
+
+	fsm.process(Event3< std::string >("oops"));
+	TEST_REQUIRE(counting_unexpected_event_handler::g_Count == 1);
+	TEST_REQUIRE(counting_unexpected_event_handler::g_LastStateID == InitialState::state_id);
+
+	fsm.process(Event1()); // switches to State1
+	fsm.process(Event3< std::string >("yo-ho-ho")); // switches to State2
+	fsm.process(Event3< std::string >("oops")); // State2 accepts any events, switches to FinalState
+	fsm.process(Event3< std::string >("oops"));
+	TEST_REQUIRE(counting_unexpected_event_handler::g_Count == 2);
+	TEST_REQUIRE(counting_unexpected_event_handler::g_LastStateID == FinalState::state_id);
+
+	// The library also provides a handler that silently ignores unexpected events
+	typedef fsm::state_machine< StatesList_t, void, void, fsm::ignore_unexpected_events > IgnoringStateMachine_t;
+	IgnoringStateMachine_t fsm2;
+	fsm2.process(Event3< std::string >("oops"));
+	TEST_REQUIRE(fsm2.is_in_state< InitialState >());
+}
+
+//! The tag for the shared unexpected event handler
+struct shared_handler_tag;
+
+unsigned int g_SharedHandlerCount = 0;
+
+void my_shared_unexpected_event_handler(boost::any const& evt, fsm::state_id_t)
+{
+	if (evt.type() == typeid(Event3< std::string >))
+		++g_SharedHandlerCount;
+}
+
+BOOST_AUTO_TEST_CASE(shared_unexpected_events_handling)
+{
+	TEST_ENTER(shared_unexpected_events_handling);
+
+	typedef fsm::shared_unexpected_event_handler< shared_handler_tag > SharedHandler_t;
+	typedef fsm::state_machine< StatesList_t, void, void, SharedHandler_t > SharedStateMachine_t;
+
+	// Machines with statically configured handlers don't store the handler in every instance
+	TEST_REQUIRE(sizeof(SharedStateMachine_t) < sizeof(StateMachine_t));
+
+	SharedHandler_t::set_handler(&my_shared_unexpected_event_handler);
+
+	SharedStateMachine_t fsm1, fsm2;
+	fsm1.process(Event3< std::string >("oops"));
+	fsm2.process(Event3< std::string >("oops"));
+	TEST_REQUIRE(g_SharedHandlerCount == 2);
+
+	SharedHandler_t::reset_handler();
+}
+
 BOOST_AUTO_TEST_CASE(bad_state_ids_handling)
 {
 	TEST_ENTER(bad_state_ids_handling);
@@ -360,6 +455,39 @@ BOOST_AUTO_TEST_CASE(bad_state_ids_handling)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(error_codes_handling)
+{
+	TEST_ENTER(error_codes_handling);
+
+	StateMachine_t fsm;
+
+	// Unexpected events are reported without calling the unexpected events handler
+	fsm::result< void > res = fsm.try_process(Event3< std::string >("oops"));
+	TEST_REQUIRE(!res);
+	TEST_REQUIRE(res.status() == fsm::errc::unexpected_event);
+	TEST_REQUIRE(fsm.is_in_state< InitialState >());
+
+	res = fsm.try_process(Event2());
+	TEST_REQUIRE(res.succeeded());
+	TEST_REQUIRE(fsm.is_in_state< State2 >());
+	fsm.process(Event2());
+	TEST_REQUIRE(fsm.is_in_state< FinalState >());
+
+	// Lets try to switch to invalid state
+	TEST_REQUIRE(fsm.try_process(TrySwitchEvent(100)));
+	TEST_REQUIRE(fsm.get< FinalState >().m_SwitchStatus == fsm::errc::bad_state_id);
+	TEST_REQUIRE(fsm.is_in_state< FinalState >());
+
+	fsm.process(TrySwitchEvent(State1::state_id));
+	TEST_REQUIRE(fsm.is_in_state< State1 >());
+
+	// Lets try to get name of invalid state
+	fsm::result< std::string const& > name = fsm.try_get_state_name(fsm::state_id_t(100));
+	TEST_REQUIRE(name.status() == fsm::errc::bad_state_id);
+	name = fsm.try_get_state_name(InitialState::state_id);
+	TEST_REQUIRE(name && name.value() == "Initial state");
+}
+
 BOOST_AUTO_TEST_CASE(accessors)
 {
 	TEST_ENTER(accessors);
@@ -371,10 +499,13 @@ BOOST_AUTO_TEST_CASE(accessors)
 
 	std::string state_name2 = fsm.get_state_name(State2::state_id);
 	TEST_REQUIRE(state_name2 == State2::get_state_name());
+	TEST_REQUIRE(state_name2.find("State2") != std::string::npos);
+	TEST_REQUIRE(&fsm.get_state_name(State2::state_id) == &State2::get_state_name());
 
 	// get_state
 	TEST_REQUIRE(fsm.get_current_state_type() == typeid(InitialState));
 	TEST_REQUIRE(fsm.get_state_type(State1::state_id) == typeid(State1));
+	TEST_REQUIRE(boost::typeindex::type_index(fsm.get_current_state_type()) == boost::typeindex::type_id< InitialState >());
 
 	// get_state_id
 	TEST_REQUIRE(fsm.get_current_state_id() == InitialState::state_id);
@@ -421,3 +552,146 @@ BOOST_AUTO_TEST_CASE(copying)
 	TEST_REQUIRE(fsm2.get< State1 >().m_Event3Received == fsm1.get< State1 >().m_Event3Received);
 	TEST_REQUIRE(fsm2.get< InitialState >().m_EventsTrace == fsm1.get< InitialState >().m_EventsTrace);
 }
+
+BOOST_AUTO_TEST_CASE(type_erasure)
+{
+	TEST_ENTER(type_erasure);
+
+	typedef boost::mpl::vector< Event1, Event2, Event3< int > >::type Events_t;
+	typedef fsm::state_machine< StatesList_t, void, void, fsm::ignore_unexpected_events > IgnoringStateMachine_t;
+
+	// The machine may be stored in the internal buffer or in the heap, depending on its size
+	typedef fsm::any_state_machine< Events_t, void, sizeof(StateMachine_t) > InBufferMachine_t;
+	typedef fsm::any_state_machine< Events_t, void, 1 > InHeapMachine_t;
+
+	InBufferMachine_t any1;
+	TEST_REQUIRE(any1.empty());
+	StateMachine_t& fsm = any1.emplace< StateMachine_t >();
+	TEST_REQUIRE(!any1.empty());
+	TEST_REQUIRE(any1.target< StateMachine_t >() == &fsm);
+	TEST_REQUIRE(any1.target< IgnoringStateMachine_t >() == NULL);
+	TEST_REQUIRE(any1.get_current_state_id() == InitialState::state_id);
+
+	any1.process(Event1()); // switches to State1
+	any1.process(Event3< int >(10)); // switches to State2
+	TEST_REQUIRE(fsm.is_in_state< State2 >());
+	TEST_REQUIRE(any1.get_current_state_name() == fsm.get_current_state_name());
+	any1.reset();
+	TEST_REQUIRE(fsm.is_in_state< InitialState >());
+
+	StateMachine_t fsm2;
+	fsm2.process(Event1()); // switches to State1
+	InHeapMachine_t any2(fsm2);
+	TEST_REQUIRE(any2.target< StateMachine_t >() != NULL);
+	TEST_REQUIRE(any2.target< StateMachine_t >() != &fsm2);
+	any2.process(Event2()); // switches to FinalState
+	TEST_REQUIRE(any2.get_current_state_id() == FinalState::state_id);
+	TEST_REQUIRE(fsm2.is_in_state< State1 >());
+
+	// Machines of different types can be stored in the same object
+	any2.emplace< IgnoringStateMachine_t >();
+	TEST_REQUIRE(any2.target< StateMachine_t >() == NULL);
+	any2.process(Event3< int >(10)); // ignored
+	TEST_REQUIRE(any2.get_current_state_id() == InitialState::state_id);
+
+	any2.clear();
+	TEST_REQUIRE(any2.empty());
+}
+
+//! The definition of a dynamic state machine
+const char g_TurnstileDefinition[] =
+	"# A turnstile\n"
+	"state Locked\n"
+	"state Unlocked\n"
+	"event coin\n"
+	"event push\n"
+	"\n"
+	"transition Locked coin Unlocked 1\n"
+	"transition Unlocked push Locked # no action\n"
+	"transition Unlocked coin Unlocked 2\n";
+
+unsigned int g_DynamicUnexpectedEvent = 0;
+
+void my_dynamic_unexpected_event_handler(boost::any const& evt, fsm::type_info_t const& state, fsm::state_id_t id)
+{
+	if (evt.type() == typeid(fsm::dynamic_event) && state == typeid(fsm::dynamic_state))
+		g_DynamicUnexpectedEvent = boost::any_cast< fsm::dynamic_event >(evt).id + 10 * id;
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_state_machines)
+{
+	TEST_ENTER(dynamic_state_machines);
+
+	std::istringstream strm(g_TurnstileDefinition);
+	boost::shared_ptr< fsm::dynamic_machine_definition > definition(new fsm::dynamic_machine_definition(strm));
+	TEST_REQUIRE(definition->states_count() == 2);
+	TEST_REQUIRE(definition->events_count() == 2);
+	TEST_REQUIRE(definition->transitions_count() == 3);
+
+	const fsm::event_id_t coin = definition->find_event("coin").get(), push = definition->find_event("push").get();
+	const fsm::state_id_t unlocked = definition->find_state("Unlocked").get();
+	TEST_REQUIRE(!definition->find_state("Broken"));
+
+	fsm::dynamic_state_machine< > machine(definition);
+	TEST_REQUIRE(machine.get_current_state_name() == "Locked");
+	TEST_REQUIRE(machine.process(coin) == 1u);
+	TEST_REQUIRE(machine.is_in_state(unlocked));
+	TEST_REQUIRE(machine.process(coin) == 2u);
+	TEST_REQUIRE(machine.process(push) == 0u);
+	TEST_REQUIRE(machine.get_current_state_name() == "Locked");
+
+	// Unexpected events are handled the same way as in the static state machines
+	try
+	{
+		machine.process(push);
+		TEST_REQUIRE(false);
+	}
+	catch (fsm::unexpected_event& e)
+	{
+		TEST_REQUIRE(e.current_state_id() == 0);
+		TEST_REQUIRE(std::string(e.what()).find("Locked") != std::string::npos);
+	}
+
+	machine.set_unexpected_event_handler(&my_dynamic_unexpected_event_handler);
+	machine.process(coin);
+	machine.process(push);
+	machine.process(push);
+	TEST_REQUIRE(g_DynamicUnexpectedEvent == push);
+
+	fsm::dynamic_state_machine< fsm::ignore_unexpected_events > ignoring(definition);
+	TEST_REQUIRE(ignoring.process(push) == 0u);
+	TEST_REQUIRE(ignoring.get_current_state_id() == 0u);
+
+	// Errors in the definition are reported with the line number
+	std::istringstream bad_strm("state A\nevent e\ntransition A e B\n");
+	try
+	{
+		fsm::dynamic_machine_definition bad_definition(bad_strm);
+		TEST_REQUIRE(false);
+	}
+	catch (fsm::bad_machine_definition& e)
+	{
+		TEST_REQUIRE(e.line() == 3);
+	}
+
+	// Negative action identifiers and trailing text are rejected
+	const char* const bad_transitions[] =
+	{
+		"transition A e B -1\n",
+		"transition A e B 7 garbage here\n",
+		"transition A e B 7x\n"
+	};
+	for (unsigned int i = 0; i < sizeof(bad_transitions) / sizeof(*bad_transitions); ++i)
+	{
+		std::istringstream bad_action_strm(std::string("state A\nstate B\nevent e\n") + bad_transitions[i]);
+		try
+		{
+			fsm::dynamic_machine_definition bad_definition(bad_action_strm);
+			TEST_REQUIRE(false);
+		}
+		catch (fsm::bad_machine_definition& e)
+		{
+			TEST_REQUIRE(e.line() == 4);
+		}
+	}
+}
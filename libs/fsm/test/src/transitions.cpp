@@ -11,7 +11,15 @@
 #include "stdafx.hpp"
 #include <boost/mpl/bool.hpp>
 #include <boost/mpl/list.hpp>
+#include <boost/mpl/empty.hpp>
+#include <boost/mpl/equal.hpp>
+#include <boost/static_assert.hpp>
 #include <boost/fsm/transition.hpp>
+#include <boost/fsm/in_state.hpp>
+#include <boost/fsm/event.hpp>
+#include <boost/fsm/table_state_machine.hpp>
+#include <boost/fsm/machine_array.hpp>
+#include <boost/fsm/packed_machine_array.hpp>
 #include "boost_testing_helpers.hpp"
 
 namespace TransitionsTest {
@@ -194,3 +202,939 @@ BOOST_AUTO_TEST_CASE(any_state_support)
 	fsm.process(StraightToEnd()); // once again, switches to FinalState
 	TEST_REQUIRE(fsm.is_in_state< FinalState >());
 }
+
+namespace TransitionsTest {
+
+	// The function object processes events in the known state
+	struct State2Processor
+	{
+		void operator() (fsm::in_state< State2, StateMachine_t > const& handle) const
+		{
+			handle.process(Event2()); // does not switch (no transition applies)
+			BOOST_REQUIRE(handle.is_valid());
+
+			handle.process(Event3< int >(10)); // switches to FinalState
+			BOOST_REQUIRE(!handle.is_valid());
+			BOOST_REQUIRE(handle.get_state_machine().is_in_state< FinalState >());
+
+			handle.process(Event3< int >(10)); // the handle falls back to the table dispatch
+			BOOST_REQUIRE(handle.get_state_machine().is_in_state< FinalState >());
+		}
+	};
+
+} // namespace TransitionsTest
+
+BOOST_AUTO_TEST_CASE(known_state_processing)
+{
+	TEST_ENTER(known_state_processing);
+
+	StateMachine_t fsm;
+	TEST_REQUIRE(!fsm::with_state< State2 >(fsm, State2Processor()));
+
+	// Transitions are performed as usual
+	fsm.process_in_state< InitialState >(Event2()); // switches to State2
+	TEST_REQUIRE(fsm.is_in_state< State2 >());
+
+	TEST_REQUIRE(fsm::with_state< State2 >(fsm, State2Processor()));
+	TEST_REQUIRE(fsm.is_in_state< FinalState >());
+
+	// If the state guess is wrong the event is dispatched as usual
+	fsm.process_in_state< State1 >(StraightToEnd());
+	TEST_REQUIRE(fsm.is_in_state< FinalState >());
+}
+
+#if defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+
+BOOST_AUTO_TEST_CASE(variant_events_processing)
+{
+	TEST_ENTER(variant_events_processing);
+
+	typedef std::variant< Event1, Event2, Event3< int >, StraightToEnd > Event_t;
+
+	StateMachine_t fsm;
+	fsm.process(Event_t(Event2())); // switches to State2
+	TEST_REQUIRE(fsm.is_in_state< State2 >());
+
+	fsm.process(Event_t(Event2())); // does not switch (no transition applies)
+	TEST_REQUIRE(fsm.is_in_state< State2 >());
+
+	fsm.process(Event_t(Event3< int >(10))); // switches to FinalState
+	TEST_REQUIRE(fsm.is_in_state< FinalState >());
+
+	fsm.reset();
+	try
+	{
+		// No handler and no transition for this event in InitialState
+		fsm.process(Event_t(Event3< int >(10)));
+		TEST_REQUIRE(false);
+	}
+	catch (fsm::unexpected_event& e)
+	{
+		TEST_REQUIRE(e.event().type() == typeid(Event3< int >));
+	}
+
+	fsm.process(Event_t(StraightToEnd())); // switches to FinalState
+	TEST_REQUIRE(fsm.is_in_state< FinalState >());
+}
+
+#endif // defined(BOOST_FSM_HAS_VARIANT_EVENTS)
+
+BOOST_AUTO_TEST_CASE(events_acceptance)
+{
+	TEST_ENTER(events_acceptance);
+
+	// The check is made in compile time and takes both event handlers and transitions into account
+	BOOST_STATIC_ASSERT((StateMachine_t::accepts_event< InitialState, Event1 >::value));
+	BOOST_STATIC_ASSERT((!StateMachine_t::accepts_event< InitialState, Event3< int > >::value));
+	BOOST_STATIC_ASSERT((StateMachine_t::accepts_event< State1, Event2 >::value));
+	BOOST_STATIC_ASSERT((!StateMachine_t::accepts_event< State2, Event1 >::value));
+	BOOST_STATIC_ASSERT((StateMachine_t::accepts_event< State2, StraightToEnd >::value));
+
+	StateMachine_t fsm;
+	TEST_REQUIRE(fsm.can_process< Event1 >()); // there is a transition
+	TEST_REQUIRE(!fsm.can_process< Event3< int > >());
+	TEST_REQUIRE(fsm.is_in_state< InitialState >()); // the check has no side effects
+
+	fsm.process(Event1()); // switches to State1
+	TEST_REQUIRE(fsm.can_process< Event2 >()); // there is a handler
+	TEST_REQUIRE(fsm.can_process< Event3< double > >());
+	TEST_REQUIRE(!fsm.can_process< Event3< int > >());
+
+	// The accepted events may also be queried as a set of events indices
+	typedef boost::mpl::vector< Event1, Event2, Event3< int >, StraightToEnd >::type Events_t;
+	std::bitset< 4 > accepted = fsm.accepted_events< Events_t >(fsm.get_current_state_id());
+	TEST_REQUIRE(accepted.to_ulong() == 0xB); // all except Event3< int >
+
+	accepted = fsm.accepted_events< Events_t >(State2::state_id);
+	TEST_REQUIRE(accepted.to_ulong() == 0xE); // all except Event1
+
+	bool bad_state_id_caught = false;
+	try
+	{
+		fsm.accepted_events< Events_t >(100);
+	}
+	catch (fsm::bad_state_id&)
+	{
+		bad_state_id_caught = true;
+	}
+	TEST_REQUIRE(bad_state_id_caught);
+}
+
+namespace TryProcessTest {
+
+	// Event classes
+	struct Start {};
+	struct Go {};
+	struct Stop {};
+
+	struct Idle;
+	struct Busy;
+
+	typedef boost::mpl::vector< Idle, Busy >::type StatesList_t;
+
+	struct Idle :
+		public fsm::state< Idle, StatesList_t >
+	{
+		void on_process(Stop const&) {}
+	};
+
+	// Busy does not handle Start, although the transition to Busy is made on Start
+	struct Busy :
+		public fsm::state< Busy, StatesList_t >
+	{
+		void on_process(Go const&) {}
+	};
+
+	typedef boost::mpl::vector<
+		fsm::transition< Idle, Start, Busy >,
+		fsm::transition< Idle, Go, Busy >,
+		fsm::transition< Busy, Stop, Idle >
+	>::type TransitionsList_t;
+
+	typedef fsm::state_machine< StatesList_t, void, TransitionsList_t > TryStateMachine_t;
+
+} // namespace TryProcessTest
+
+BOOST_AUTO_TEST_CASE(try_process_transitions)
+{
+	TEST_ENTER(try_process_transitions);
+
+	using namespace TryProcessTest;
+
+	TryStateMachine_t fsm;
+
+	// The target state of the transition accepts the event
+	TEST_REQUIRE(fsm.try_process(Go()).succeeded());
+	TEST_REQUIRE(fsm.is_in_state< Busy >());
+	TEST_REQUIRE(fsm.try_process(Stop()).succeeded());
+	TEST_REQUIRE(fsm.is_in_state< Idle >());
+
+	// The target state of the transition does not accept the event, the transition is not performed
+	TEST_REQUIRE(fsm.can_process< Start >());
+	fsm::result< void > res = fsm.try_process(Start());
+	TEST_REQUIRE(res.status() == fsm::errc::unexpected_event);
+	TEST_REQUIRE(fsm.is_in_state< Idle >());
+}
+
+namespace NextStateTest {
+
+	// Event classes
+	struct Start {};
+	struct Finish
+	{
+		bool succeeded;
+		explicit Finish(bool ok) : succeeded(ok) {}
+	};
+	struct Retry {};
+
+	// Forward-declaration of state classes
+	struct Idle;
+	struct Working;
+	struct Done;
+
+	// Definition of states type list
+	typedef boost::mpl::vector<
+		Idle,
+		Working,
+		Done
+	>::type StatesList_t;
+
+	// Event handlers may name the next state instead of calling switch_to
+	struct Idle :
+		public fsm::state< Idle, StatesList_t >
+	{
+		fsm::next< Working > on_process(Start const&)
+		{
+			return fsm::next< Working >();
+		}
+	};
+
+	struct Working :
+		public fsm::state< Working, StatesList_t >
+	{
+		unsigned int m_EnterCount;
+
+		Working() : m_EnterCount(0) {}
+
+		void on_enter_state()
+		{
+			++m_EnterCount;
+		}
+
+		// The handler may select one of several states or no transition at all
+		typedef fsm::next< Done, Idle > finish_result;
+		finish_result on_process(Finish const& evt)
+		{
+			if (evt.succeeded)
+				return finish_result::to< Done >();
+			else
+				return finish_result::to< Idle >();
+		}
+		fsm::next< Done > on_process(Retry const&)
+		{
+			return fsm::next< Done >::stay();
+		}
+	};
+
+	struct Done :
+		public fsm::state< Done, StatesList_t >
+	{
+		// Handlers of the usual kind may be mixed with the ones that return the next state
+		void on_process(Retry const&)
+		{
+			switch_to< Idle >();
+		}
+	};
+
+	// State machine type declaration
+	typedef fsm::state_machine< StatesList_t > NextStateMachine_t;
+
+} // namespace NextStateTest
+
+BOOST_AUTO_TEST_CASE(next_state_handlers)
+{
+	TEST_ENTER(next_state_handlers);
+
+	using namespace NextStateTest;
+
+	NextStateMachine_t fsm;
+	fsm.process(Start()); // switches to Working
+	TEST_REQUIRE(fsm.is_in_state< Working >());
+	TEST_REQUIRE(fsm.get< Working >().m_EnterCount == 1);
+
+	fsm.process(Retry()); // stays in Working
+	TEST_REQUIRE(fsm.is_in_state< Working >());
+	TEST_REQUIRE(fsm.get< Working >().m_EnterCount == 1);
+
+	fsm.process(Finish(false)); // switches to Idle
+	TEST_REQUIRE(fsm.is_in_state< Idle >());
+
+	fsm.process_in_state< Idle >(Start()); // switches to Working
+	fsm.process(Finish(true)); // switches to Done
+	TEST_REQUIRE(fsm.is_in_state< Done >());
+	TEST_REQUIRE(fsm.get< Working >().m_EnterCount == 2);
+
+	fsm.process(Retry()); // switches to Idle
+	TEST_REQUIRE(fsm.is_in_state< Idle >());
+}
+
+namespace SparseDispatchTest {
+
+	// Event classes
+	struct Next {};
+	struct Other {};
+
+	// States of the ring, only a few of them accept the Next event
+	template< unsigned int N >
+	struct Ring;
+
+	typedef boost::mpl::vector<
+		Ring< 0 >, Ring< 1 >, Ring< 2 >, Ring< 3 >, Ring< 4 >, Ring< 5 >,
+		Ring< 6 >, Ring< 7 >, Ring< 8 >, Ring< 9 >, Ring< 10 >, Ring< 11 >
+	>::type StatesList_t;
+
+	template< unsigned int N >
+	struct Ring :
+		public fsm::state< Ring< N >, StatesList_t >
+	{
+	};
+
+	template< >
+	struct Ring< 3 > :
+		public fsm::state< Ring< 3 >, StatesList_t >
+	{
+		void on_process(Next const&)
+		{
+			switch_to< Ring< 7 > >();
+		}
+	};
+
+	template< >
+	struct Ring< 7 > :
+		public fsm::state< Ring< 7 >, StatesList_t >
+	{
+		void on_process(Next const&)
+		{
+			switch_to< Ring< 0 > >();
+		}
+	};
+
+	typedef boost::mpl::vector<
+		fsm::transition< Ring< 0 >, Other, Ring< 3 > >
+	>::type TransitionsMap_t;
+
+	typedef fsm::state_machine< StatesList_t, void, TransitionsMap_t > SparseStateMachine_t;
+
+	// The unexpected events handler records the state in which the event was received
+	struct unexpected_event_recorder
+	{
+		fsm::state_id_t* m_pStateID;
+		boost::typeindex::type_index* m_pStateType;
+
+		unexpected_event_recorder(fsm::state_id_t* pStateID, boost::typeindex::type_index* pStateType) :
+			m_pStateID(pStateID),
+			m_pStateType(pStateType)
+		{
+		}
+
+		void operator() (boost::any const&, fsm::type_info_t const& state_type, fsm::state_id_t state_id) const
+		{
+			*m_pStateID = state_id;
+			*m_pStateType = boost::typeindex::type_index(state_type);
+		}
+	};
+
+} // namespace SparseDispatchTest
+
+BOOST_AUTO_TEST_CASE(sparse_dispatching)
+{
+	TEST_ENTER(sparse_dispatching);
+
+	using namespace SparseDispatchTest;
+
+	SparseStateMachine_t fsm;
+	fsm::state_id_t unexpected_state_id = 100;
+	boost::typeindex::type_index unexpected_state_type;
+	fsm.set_unexpected_event_handler(unexpected_event_recorder(&unexpected_state_id, &unexpected_state_type));
+
+	// The states that do not accept the event share the same dispatching table entry,
+	// but the unexpected events handler still receives the actual current state
+	fsm.process(Next());
+	TEST_REQUIRE(unexpected_state_id == Ring< 0 >::state_id);
+	TEST_REQUIRE(unexpected_state_type == boost::typeindex::type_id< Ring< 0 > >());
+
+	fsm.process(Other()); // switches to Ring< 3 >, where the event is unexpected
+	TEST_REQUIRE(fsm.is_in_state< Ring< 3 > >());
+	TEST_REQUIRE(unexpected_state_id == Ring< 3 >::state_id);
+	TEST_REQUIRE(unexpected_state_type == boost::typeindex::type_id< Ring< 3 > >());
+
+	fsm.process(Next()); // switches to Ring< 7 >
+	TEST_REQUIRE(fsm.is_in_state< Ring< 7 > >());
+	fsm.process(Next()); // switches to Ring< 0 >
+	TEST_REQUIRE(fsm.is_in_state< Ring< 0 > >());
+	fsm.process_in_state< Ring< 0 > >(Other()); // switches to Ring< 3 >
+	TEST_REQUIRE(fsm.is_in_state< Ring< 3 > >());
+}
+
+namespace ReachabilityTest {
+
+	// Event classes
+	struct Go {};
+	struct Back {};
+	struct Jump
+	{
+		fsm::state_id_t state_id;
+
+		explicit Jump(fsm::state_id_t id) : state_id(id) {}
+	};
+
+	// Forward-declaration of state classes
+	struct StateA;
+	struct StateB;
+	struct StateC;
+	struct Orphan;
+
+	typedef boost::mpl::vector<
+		StateA,
+		StateB,
+		StateC,
+		Orphan
+	>::type StatesList_t;
+
+	// Every state declares the states it may switch to, which enables the reachability analysis
+	struct StateA :
+		public fsm::state< StateA, StatesList_t >
+	{
+		typedef boost::mpl::vector< StateB >::type target_states_type_list;
+
+		void on_process(Go const&)
+		{
+			switch_to< StateB >();
+		}
+	};
+
+	struct StateB :
+		public fsm::state< StateB, StatesList_t >
+	{
+		typedef boost::mpl::vector< StateC >::type target_states_type_list;
+		typedef boost::mpl::vector<
+			fsm::transition< StateB, Go, StateC >
+		>::type transitions_type_list;
+	};
+
+	struct StateC :
+		public fsm::state< StateC, StatesList_t >
+	{
+		typedef boost::mpl::vector< StateA >::type target_states_type_list;
+
+		fsm::errc::type m_SwitchStatus;
+
+		StateC() : m_SwitchStatus(fsm::errc::success) {}
+
+		void on_process(Go const&) {}
+		fsm::next< StateA > on_process(Back const&)
+		{
+			return fsm::next< StateA >();
+		}
+		// The dynamic switch is also checked against the declared target states
+		void on_process(Jump const& evt)
+		{
+			m_SwitchStatus = try_switch_to(evt.state_id).status();
+		}
+	};
+
+	// No state switches to this one
+	struct Orphan :
+		public fsm::state< Orphan, StatesList_t >
+	{
+		typedef boost::mpl::vector< StateA >::type target_states_type_list;
+
+		void on_process(Go const&)
+		{
+			switch_to< StateA >();
+		}
+	};
+
+	typedef fsm::state_machine< StatesList_t > ReachabilityStateMachine_t;
+
+} // namespace ReachabilityTest
+
+BOOST_AUTO_TEST_CASE(reachability_analysis)
+{
+	TEST_ENTER(reachability_analysis);
+
+	using namespace ReachabilityTest;
+
+	typedef fsm::reachability< ReachabilityStateMachine_t > reachability_t;
+	BOOST_STATIC_ASSERT(reachability_t::is_enabled);
+	BOOST_STATIC_ASSERT((boost::mpl::equal< reachability_t::unreachable_states_type_list, boost::mpl::vector< Orphan > >::value));
+	BOOST_STATIC_ASSERT((boost::mpl::equal< reachability_t::reachable_states_type_list, boost::mpl::vector< StateA, StateB, StateC > >::value));
+
+	// The analysis is not possible if some states do not declare the states they switch to
+	BOOST_STATIC_ASSERT(!fsm::reachability< TransitionsTest::StateMachine_t >::is_enabled);
+	BOOST_STATIC_ASSERT(boost::mpl::empty< fsm::reachability< TransitionsTest::StateMachine_t >::unreachable_states_type_list >::value);
+
+	ReachabilityStateMachine_t fsm;
+	fsm.process(Go()); // switches to StateB
+	TEST_REQUIRE(fsm.is_in_state< StateB >());
+	fsm.process(Go()); // switches to StateC
+	TEST_REQUIRE(fsm.is_in_state< StateC >());
+	fsm.process(Jump(Orphan::state_id)); // StateC does not declare Orphan as a target state
+	TEST_REQUIRE(fsm.get< StateC >().m_SwitchStatus == fsm::errc::bad_state_id);
+	TEST_REQUIRE(fsm.is_in_state< StateC >());
+	fsm.process(Jump(StateA::state_id)); // switches to StateA
+	TEST_REQUIRE(fsm.get< StateC >().m_SwitchStatus == fsm::errc::success);
+	TEST_REQUIRE(fsm.is_in_state< StateA >());
+	fsm.process(Go()); // switches to StateB
+	fsm.process(Go()); // switches to StateC
+	fsm.process(Back()); // switches to StateA
+	TEST_REQUIRE(fsm.is_in_state< StateA >());
+}
+
+namespace TableTest {
+
+	// State classes, the states carry no data
+	template< unsigned int ValueV >
+	struct Bits {};
+
+	typedef boost::mpl::vector<
+		Bits< 0 >,
+		Bits< 1 >,
+		Bits< 2 >,
+		Bits< 3 >
+	>::type StatesList_t;
+
+	// Event classes
+	struct Clear {};
+
+	typedef boost::mpl::vector<
+		fsm::event_c< 0 >,
+		fsm::event_c< 1 >,
+		Clear
+	>::type EventsList_t;
+
+	// The transition flips a bit of the state value
+	struct BitTransition
+	{
+		template< typename StateT, typename EventT >
+		struct is_applicable : boost::mpl::false_ {};
+		template< unsigned int ValueV, int BitNoV >
+		struct is_applicable< Bits< ValueV >, fsm::event_c< BitNoV > > : boost::mpl::true_ {};
+
+		template< typename StateT, typename EventT >
+		struct target;
+		template< unsigned int ValueV, int BitNoV >
+		struct target< Bits< ValueV >, fsm::event_c< BitNoV > >
+		{
+			typedef Bits< ValueV ^ (1 << BitNoV) > type;
+		};
+	};
+
+	// The transition clears all bits and marks the table cell with an action
+	struct ClearTransition :
+		public fsm::transition< Bits< 3 >, Clear, Bits< 0 > >
+	{
+		typedef boost::mpl::int_< 7 > action_id;
+	};
+
+	typedef boost::mpl::vector<
+		ClearTransition,
+		BitTransition
+	>::type TransitionsList_t;
+
+	typedef fsm::table_state_machine< StatesList_t, EventsList_t, TransitionsList_t > TableStateMachine_t;
+
+} // namespace TableTest
+
+BOOST_AUTO_TEST_CASE(table_state_machines)
+{
+	TEST_ENTER(table_state_machines);
+
+	using namespace TableTest;
+
+	BOOST_STATIC_ASSERT(sizeof(TableStateMachine_t) == 1);
+
+	TableStateMachine_t fsm;
+	TEST_REQUIRE(fsm.is_in_state< Bits< 0 > >());
+	TEST_REQUIRE(fsm.process(fsm::make_event< 0 >()) == 0u);
+	TEST_REQUIRE(fsm.is_in_state< Bits< 1 > >());
+	TEST_REQUIRE(fsm.process(Clear()) == 0u); // no applicable rule, the state is not changed
+	TEST_REQUIRE(fsm.is_in_state< Bits< 1 > >());
+	fsm.process_index(1);
+	TEST_REQUIRE(fsm.is_in_state< Bits< 3 > >());
+	TEST_REQUIRE(fsm.get_current_state_id() == 3u);
+
+	// The machine is a plain value
+	TableStateMachine_t copy = fsm;
+	TEST_REQUIRE(copy.process(Clear()) == 7u);
+	TEST_REQUIRE(copy.is_in_state< Bits< 0 > >());
+	TEST_REQUIRE(fsm.is_in_state< Bits< 3 > >());
+
+	fsm.reset();
+	TEST_REQUIRE(fsm.is_in_state< Bits< 0 > >());
+}
+
+namespace PrebuiltTableTest {
+
+	using TableTest::Bits;
+	using TableTest::Clear;
+	using TableTest::StatesList_t;
+	using TableTest::EventsList_t;
+
+	// The table of TableTest::TransitionsList_t, as fsm_compiler generates it
+	struct Table
+	{
+		static const unsigned int states_count = 4;
+		static const unsigned int events_count = 3;
+		static const unsigned int max_action_id = 7;
+
+		static const unsigned char next_states[4][3];
+		static const unsigned char actions[4][3];
+	};
+
+	const unsigned char Table::next_states[4][3] =
+	{
+		{ 1, 2, 0 },
+		{ 0, 3, 1 },
+		{ 3, 0, 2 },
+		{ 2, 1, 0 }
+	};
+	const unsigned char Table::actions[4][3] =
+	{
+		{ 0, 0, 0 },
+		{ 0, 0, 0 },
+		{ 0, 0, 0 },
+		{ 0, 0, 7 }
+	};
+
+	typedef fsm::table_state_machine< StatesList_t, EventsList_t, fsm::prebuilt_table< Table > > PrebuiltStateMachine_t;
+	typedef fsm::table_state_machine< StatesList_t, EventsList_t, fsm::minimized< fsm::prebuilt_table< Table > > > MinimizedStateMachine_t;
+
+} // namespace PrebuiltTableTest
+
+BOOST_AUTO_TEST_CASE(prebuilt_tables)
+{
+	TEST_ENTER(prebuilt_tables);
+
+	using namespace PrebuiltTableTest;
+
+	// The machine behaves as the one with the evaluated table
+	for (std::size_t e = 0; e < 3; ++e)
+	{
+		for (unsigned int s = 0; s < 4; ++s)
+		{
+			PrebuiltStateMachine_t prebuilt;
+			TableTest::TableStateMachine_t evaluated;
+			for (std::size_t bit = 0; bit < 2; ++bit)
+			{
+				if (s & (1u << bit))
+				{
+					prebuilt.process_index(bit);
+					evaluated.process_index(bit);
+				}
+			}
+			TEST_REQUIRE(prebuilt.get_current_state_id() == s);
+			TEST_REQUIRE(prebuilt.process_index(e) == evaluated.process_index(e));
+			TEST_REQUIRE(prebuilt.get_current_state_id() == evaluated.get_current_state_id());
+		}
+	}
+
+	PrebuiltStateMachine_t fsm;
+	fsm.process(fsm::make_event< 0 >());
+	fsm.process(fsm::make_event< 1 >());
+	TEST_REQUIRE(fsm.is_in_state< Bits< 3 > >());
+	TEST_REQUIRE(fsm.process(Clear()) == 7u);
+	TEST_REQUIRE(fsm.is_in_state< Bits< 0 > >());
+
+	// The prebuilt table can be minimized, all states are distinct
+	TEST_REQUIRE(MinimizedStateMachine_t::get_minimized_states_count() == 4u);
+}
+
+namespace MinimizationTest {
+
+	// State classes, the Accept state is distinguished by its output
+	struct Start {};
+	struct AfterA {};
+	struct AfterB {};
+	struct Accept { typedef boost::mpl::int_< 1 > output; };
+
+	typedef boost::mpl::vector<
+		Start,
+		AfterA,
+		AfterB,
+		Accept
+	>::type StatesList_t;
+
+	// Event classes
+	struct A {};
+	struct B {};
+
+	typedef boost::mpl::vector< A, B >::type EventsList_t;
+
+	// AfterA and AfterB are equivalent
+	typedef boost::mpl::vector<
+		fsm::transition< Start, A, AfterA >,
+		fsm::transition< Start, B, AfterB >,
+		fsm::transition< AfterA, A, Accept >,
+		fsm::transition< AfterA, B, Start >,
+		fsm::transition< AfterB, A, Accept >,
+		fsm::transition< AfterB, B, Start >
+	>::type TransitionsList_t;
+
+	typedef fsm::table_state_machine< StatesList_t, EventsList_t, fsm::minimized< TransitionsList_t > > MinimizedStateMachine_t;
+	typedef fsm::table_state_machine< StatesList_t, EventsList_t, TransitionsList_t > PlainStateMachine_t;
+
+} // namespace MinimizationTest
+
+BOOST_AUTO_TEST_CASE(table_states_minimization)
+{
+	TEST_ENTER(table_states_minimization);
+
+	using namespace MinimizationTest;
+
+	TEST_REQUIRE(MinimizedStateMachine_t::get_minimized_states_count() == 3u);
+	TEST_REQUIRE(PlainStateMachine_t::get_minimized_states_count() == 4u);
+
+	MinimizedStateMachine_t fsm;
+	TEST_REQUIRE(fsm.is_in_state< Start >());
+	fsm.process(B());
+	TEST_REQUIRE(fsm.is_in_state< AfterB >());
+	TEST_REQUIRE(fsm.is_in_state< AfterA >()); // the states are merged
+	TEST_REQUIRE(fsm.get_current_state_id() == 1u);
+	fsm.process(B());
+	TEST_REQUIRE(fsm.is_in_state< Start >());
+	fsm.process(A());
+	fsm.process(A());
+	TEST_REQUIRE(fsm.is_in_state< Accept >());
+	TEST_REQUIRE(fsm.get_current_state_id() == 3u);
+	fsm.process(B()); // no rule, the state is not changed
+	TEST_REQUIRE(fsm.is_in_state< Accept >());
+}
+
+namespace BytesTest {
+
+	// State classes
+	struct Idle {};
+	struct Word {};
+
+	typedef boost::mpl::vector< Idle, Word >::type StatesList_t;
+
+	// Event classes
+	typedef fsm::byte_range< 'a', 'z' > Letter;
+	typedef fsm::event_c< ' ' > Space;
+	typedef fsm::event_c< '\n' > NewLine;
+
+	typedef boost::mpl::vector< Letter, Space, NewLine >::type EventsList_t;
+
+	// The transition marks the end of a word
+	struct WordEnd :
+		public fsm::transition< Word, Space, Idle >
+	{
+		typedef boost::mpl::int_< 1 > action_id;
+	};
+	// The transition marks the end of a line
+	struct LineEnd :
+		public fsm::transition< fsm::any_state, NewLine, Idle >
+	{
+		typedef boost::mpl::int_< 2 > action_id;
+	};
+
+	typedef boost::mpl::vector<
+		fsm::transition< Idle, Letter, Word >,
+		WordEnd,
+		LineEnd
+	>::type TransitionsList_t;
+
+	typedef fsm::table_state_machine< StatesList_t, EventsList_t, TransitionsList_t > BytesStateMachine_t;
+
+} // namespace BytesTest
+
+BOOST_AUTO_TEST_CASE(bytes_processing)
+{
+	TEST_ENTER(bytes_processing);
+
+	using namespace BytesTest;
+
+	const char text[] = "ab  c1d\nxy";
+	const std::size_t size = sizeof(text) - 1;
+	BytesStateMachine_t fsm;
+	unsigned int action = 0;
+
+	std::size_t pos = fsm.process_bytes(text, size, action);
+	TEST_REQUIRE(pos == 3u && action == 1u); // the word "ab" ends
+	TEST_REQUIRE(fsm.is_in_state< Idle >());
+
+	std::size_t n = fsm.process_bytes(text + pos, size - pos, action);
+	pos += n;
+	TEST_REQUIRE(pos == 8u && action == 2u); // the digit is ignored, the line ends
+	TEST_REQUIRE(fsm.is_in_state< Idle >());
+
+	n = fsm.process_bytes(text + pos, size - pos, action);
+	TEST_REQUIRE(n == 2u && action == 0u);
+	TEST_REQUIRE(fsm.is_in_state< Word >());
+}
+
+namespace MachineArrayTest {
+
+	// State classes
+	template< unsigned int N >
+	struct Node {};
+
+	typedef boost::mpl::vector<
+		Node< 0 >, Node< 1 >, Node< 2 >, Node< 3 >, Node< 4 >,
+		Node< 5 >, Node< 6 >, Node< 7 >, Node< 8 >, Node< 9 >,
+		Node< 10 >, Node< 11 >, Node< 12 >, Node< 13 >, Node< 14 >,
+		Node< 15 >, Node< 16 >, Node< 17 >, Node< 18 >, Node< 19 >
+	>::type StatesList_t;
+
+	// Event classes
+	struct Tick {};
+	struct Stop {};
+
+	typedef boost::mpl::vector< Tick, Stop >::type EventsList_t;
+
+	// The transition switches to the next node in the ring
+	struct Step
+	{
+		template< typename StateT, typename EventT >
+		struct is_applicable : boost::mpl::false_ {};
+		template< unsigned int N >
+		struct is_applicable< Node< N >, Tick > : boost::mpl::true_ {};
+
+		template< typename StateT, typename EventT >
+		struct target;
+		template< unsigned int N >
+		struct target< Node< N >, Tick >
+		{
+			typedef Node< (N + 1) % 20 > type;
+		};
+	};
+
+	typedef boost::mpl::vector<
+		fsm::transition< fsm::any_state, Stop, Node< 0 > >,
+		Step
+	>::type TransitionsList_t;
+
+	typedef fsm::table_state_machine< StatesList_t, EventsList_t, TransitionsList_t > RingStateMachine_t;
+
+} // namespace MachineArrayTest
+
+BOOST_AUTO_TEST_CASE(machine_arrays)
+{
+	TEST_ENTER(machine_arrays);
+
+	// Machines with few states
+	{
+		using namespace TableTest;
+
+		fsm::machine_array< TableStateMachine_t > machines(37);
+		machines.process(1, fsm::make_event< 1 >());
+		machines.process(fsm::make_event< 0 >());
+		for (std::size_t i = 0; i < machines.size(); ++i)
+		{
+			if (i == 1)
+				TEST_REQUIRE(machines.is_in_state< Bits< 3 > >(i));
+			else
+				TEST_REQUIRE(machines.is_in_state< Bits< 1 > >(i));
+		}
+		TEST_REQUIRE(machines.process(1, Clear()) == 7u);
+		TEST_REQUIRE(machines.get_current_state_id(1) == 0u);
+	}
+
+	// Machines with more states than a single vector register holds
+	{
+		using namespace MachineArrayTest;
+
+		fsm::machine_array< RingStateMachine_t > machines(45);
+		for (std::size_t i = 0; i < machines.size(); ++i)
+		{
+			for (std::size_t j = 0; j < i; ++j)
+				machines.process(i, Tick());
+		}
+		for (unsigned int n = 0; n < 7; ++n)
+			machines.process(Tick());
+		for (std::size_t i = 0; i < machines.size(); ++i)
+			TEST_REQUIRE(machines.get_current_state_id(i) == (i + 7) % 20);
+
+		machines.resize(50);
+		TEST_REQUIRE(machines.is_in_state< Node< 0 > >(49));
+		machines.process(Stop());
+		for (std::size_t i = 0; i < machines.size(); ++i)
+			TEST_REQUIRE(machines.is_in_state< Node< 0 > >(i));
+	}
+}
+
+namespace PackedTest {
+
+	// State classes
+	struct Off {};
+	struct On {};
+
+	typedef boost::mpl::vector< Off, On >::type StatesList_t;
+
+	// Event classes
+	struct Toggle {};
+	struct SwitchOn {};
+
+	typedef boost::mpl::vector< Toggle, SwitchOn >::type EventsList_t;
+
+	typedef boost::mpl::vector<
+		fsm::transition< Off, Toggle, On >,
+		fsm::transition< On, Toggle, Off >,
+		fsm::transition< fsm::any_state, SwitchOn, On >
+	>::type TransitionsList_t;
+
+	typedef fsm::table_state_machine< StatesList_t, EventsList_t, TransitionsList_t > SwitchStateMachine_t;
+
+} // namespace PackedTest
+
+BOOST_AUTO_TEST_CASE(packed_machine_arrays)
+{
+	TEST_ENTER(packed_machine_arrays);
+
+	// One bit per machine
+	{
+		using namespace PackedTest;
+
+		typedef fsm::packed_machine_array< SwitchStateMachine_t > machines_t;
+		BOOST_STATIC_ASSERT(machines_t::bits_per_machine == 1);
+
+		machines_t machines(100);
+		for (std::size_t i = 0; i < machines.size(); i += 3)
+			machines.process(i, Toggle());
+		TEST_REQUIRE(machines.count_in_state< On >() == 34u);
+		machines.process(Toggle());
+		TEST_REQUIRE(machines.count_in_state< On >() == 66u);
+		TEST_REQUIRE(machines.is_in_state< Off >(0));
+		TEST_REQUIRE(machines.is_in_state< On >(1));
+
+		// The added machines are in the initial state
+		machines.resize(130);
+		TEST_REQUIRE(machines.count_in_state< Off >() == 34u + 30u);
+		machines.process(SwitchOn());
+		TEST_REQUIRE(machines.count_in_state< On >() == 130u);
+	}
+
+	// Two bits per machine
+	{
+		using namespace TableTest;
+
+		typedef fsm::packed_machine_array< TableStateMachine_t > machines_t;
+		BOOST_STATIC_ASSERT(machines_t::bits_per_machine == 2);
+
+		machines_t machines(70);
+		for (std::size_t i = 0; i < machines.size(); i += 2)
+			machines.process(i, fsm::make_event< 1 >());
+		machines.process(fsm::make_event< 0 >());
+		for (std::size_t i = 0; i < machines.size(); ++i)
+			TEST_REQUIRE(machines.get_current_state_id(i) == ((i % 2) == 0 ? 3u : 1u));
+		TEST_REQUIRE(machines.count_in_state< Bits< 3 > >() == 35u);
+
+		machines.process(Clear());
+		TEST_REQUIRE(machines.count_in_state< Bits< 0 > >() == 35u);
+		TEST_REQUIRE(machines.count_in_state< Bits< 1 > >() == 35u);
+		TEST_REQUIRE(machines.process(1, fsm::make_event< 1 >()) == 0u);
+		TEST_REQUIRE(machines.process(1, Clear()) == 7u);
+		TEST_REQUIRE(machines.count_in_state< Bits< 0 > >() == 36u);
+	}
+}
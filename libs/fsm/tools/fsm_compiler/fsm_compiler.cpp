@@ -0,0 +1,501 @@
+/*!
+* (C) 2026 Andrey Semashev
+*
+* Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+* (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*
+* \file   fsm_compiler.cpp
+* \author Andrey Semashev
+* \date   18.10.2026
+*
+* \brief  The tool that generates static state machine definitions from SCXML documents or transition tables
+*
+* The tool reads a state machine specification and writes a header with the state and event classes,
+* the states and events lists, the transitions map and the prebuilt transition table for table_state_machine.
+*
+* Usage: fsm_compiler [--format scxml|csv|fsm] [--namespace name] [--output file] input
+*
+* The format is detected by the input file extension if not specified. The supported formats are:
+* - scxml. The top-level state and final elements with the transition children are supported,
+*   the transitions may have several space-separated events and a single target. The initial state
+*   is specified by the initial attribute of the scxml element or is the first state.
+*   Compound and parallel states, eventless and targetless transitions and executable content are not supported.
+* - csv. Every line contains a transition in the form "state,event,next_state[,action]". Empty lines and lines
+*   that start with '#' are ignored. The states and events are numbered in the order of appearance,
+*   the first state is the initial one.
+* - fsm. The text format of dynamic_machine_definition.
+*/
+
+#include <set>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include <boost/shared_ptr.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <boost/fsm/dynamic_state_machine.hpp>
+
+using namespace boost;
+
+typedef fsm::dynamic_machine_definition definition_t;
+
+//! The maximum number of elements in a single MPL vector in the generated code
+enum { MAX_VECTOR_SIZE = 50 };
+
+//////////////////////////////////////////////////////////////////////////
+//  Specification parsers
+//////////////////////////////////////////////////////////////////////////
+
+//! The function removes the leading and trailing spaces and quotes
+std::string trim(std::string const& str)
+{
+    std::string::size_type begin = str.find_first_not_of(" \t\r\""), end = str.find_last_not_of(" \t\r\"");
+    if (begin == std::string::npos)
+        return std::string();
+    return str.substr(begin, end - begin + 1);
+}
+
+//! The function returns the identifier of the state and adds the state if it is not defined yet
+fsm::state_id_t get_state(definition_t& definition, std::string const& name)
+{
+    optional< fsm::state_id_t > id = definition.find_state(name);
+    return id ? id.get() : definition.add_state(name);
+}
+
+//! The function returns the identifier of the event and adds the event if it is not defined yet
+fsm::event_id_t get_event(definition_t& definition, std::string const& name)
+{
+    optional< fsm::event_id_t > id = definition.find_event(name);
+    return id ? id.get() : definition.add_event(name);
+}
+
+//! The function loads the transitions table in CSV format
+void load_csv(definition_t& definition, std::istream& strm)
+{
+    std::string line;
+    for (unsigned int line_no = 1; std::getline(strm, line); ++line_no)
+    {
+        if (trim(line).empty() || trim(line)[0] == '#')
+            continue;
+
+        std::vector< std::string > fields;
+        std::istringstream line_strm(line);
+        std::string field;
+        while (std::getline(line_strm, field, ','))
+            fields.push_back(trim(field));
+        if (fields.size() < 3 || fields.size() > 4 || fields[0].empty() || fields[1].empty() || fields[2].empty())
+            boost::throw_exception(fsm::bad_machine_definition("invalid transition", line_no));
+
+        unsigned int action = 0;
+        if (fields.size() == 4 && !fields[3].empty())
+        {
+            std::istringstream action_strm(fields[3]);
+            if (!(action_strm >> action) || !action_strm.eof())
+                boost::throw_exception(fsm::bad_machine_definition("invalid action identifier", line_no));
+        }
+
+        const fsm::state_id_t current = get_state(definition, fields[0]);
+        const fsm::event_id_t event = get_event(definition, fields[1]);
+        const fsm::state_id_t next = get_state(definition, fields[2]);
+        if (definition.find_transition(current, event))
+        {
+            boost::throw_exception(fsm::bad_machine_definition(
+                "transition from state '" + fields[0] + "' on event '" + fields[1] + "' is already defined", line_no));
+        }
+        definition.add_transition(current, event, next, action);
+    }
+
+    if (definition.states_count() == 0)
+        boost::throw_exception(fsm::bad_machine_definition("no states are defined"));
+}
+
+//! The function checks if the SCXML element is a state
+inline bool is_scxml_state(std::string const& element)
+{
+    return (element == "state" || element == "final");
+}
+
+//! The function loads the SCXML document
+void load_scxml(definition_t& definition, std::istream& strm)
+{
+    typedef property_tree::ptree ptree;
+    ptree document;
+    property_tree::read_xml(strm, document);
+
+    ptree const& root = document.get_child("scxml");
+    std::string initial = root.get("<xmlattr>.initial", std::string());
+
+    // The initial state is added first
+    bool initial_defined = false;
+    for (ptree::const_iterator it = root.begin(), end = root.end(); it != end; ++it)
+    {
+        if (it->first == "parallel")
+            boost::throw_exception(fsm::bad_machine_definition("parallel states are not supported"));
+        if (!is_scxml_state(it->first))
+            continue;
+
+        std::string id = it->second.get< std::string >("<xmlattr>.id");
+        if (initial.empty())
+            initial = id;
+        if (id == initial)
+            initial_defined = true;
+        for (ptree::const_iterator child = it->second.begin(), child_end = it->second.end(); child != child_end; ++child)
+        {
+            if (is_scxml_state(child->first) || child->first == "parallel")
+                boost::throw_exception(fsm::bad_machine_definition("compound state '" + id + "' is not supported"));
+        }
+    }
+    if (initial.empty())
+        boost::throw_exception(fsm::bad_machine_definition("no states are defined"));
+    if (!initial_defined)
+        boost::throw_exception(fsm::bad_machine_definition("state '" + initial + "' is not defined"));
+    definition.add_state(initial);
+    for (ptree::const_iterator it = root.begin(), end = root.end(); it != end; ++it)
+    {
+        if (is_scxml_state(it->first))
+            get_state(definition, it->second.get< std::string >("<xmlattr>.id"));
+    }
+
+    // The first transition in the document order is selected if several transitions match the event
+    for (ptree::const_iterator it = root.begin(), end = root.end(); it != end; ++it)
+    {
+        if (!is_scxml_state(it->first))
+            continue;
+
+        std::string id = it->second.get< std::string >("<xmlattr>.id");
+        const fsm::state_id_t current = definition.find_state(id).get();
+        for (ptree::const_iterator child = it->second.begin(), child_end = it->second.end(); child != child_end; ++child)
+        {
+            if (child->first != "transition")
+                continue;
+
+            std::string events = child->second.get("<xmlattr>.event", std::string());
+            std::string target = trim(child->second.get("<xmlattr>.target", std::string()));
+            if (trim(events).empty())
+                boost::throw_exception(fsm::bad_machine_definition("eventless transition in state '" + id + "' is not supported"));
+            if (target.empty() || target.find_first_of(" \t\n") != std::string::npos)
+                boost::throw_exception(fsm::bad_machine_definition("transition in state '" + id + "' must have a single target"));
+
+            optional< fsm::state_id_t > next = definition.find_state(target);
+            if (!next)
+                boost::throw_exception(fsm::bad_machine_definition("state '" + target + "' is not defined"));
+
+            std::istringstream events_strm(events);
+            std::string event_name;
+            while (events_strm >> event_name)
+            {
+                const fsm::event_id_t event = get_event(definition, event_name);
+                if (!definition.find_transition(current, event))
+                    definition.add_transition(current, event, next.get());
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+//  Code generator
+//////////////////////////////////////////////////////////////////////////
+
+//! The function checks if the identifier is a C++ keyword or a name used by the generated code
+bool is_reserved(std::string const& name)
+{
+    static const char* const reserved[] =
+    {
+        "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char", "class", "compl",
+        "const", "const_cast", "continue", "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
+        "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long",
+        "mutable", "namespace", "new", "not", "not_eq", "operator", "or", "or_eq", "private", "protected", "public",
+        "register", "reinterpret_cast", "return", "short", "signed", "sizeof", "static", "static_cast", "struct",
+        "switch", "template", "this", "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned",
+        "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq", "alignas", "alignof", "char16_t",
+        "char32_t", "constexpr", "decltype", "noexcept", "nullptr", "static_assert", "thread_local", "boost",
+        "events", "states_type_list", "events_type_list", "transitions_type_list", "basic_transition_table",
+        "transition_table", "table_state_machine_type"
+    };
+    for (std::size_t i = 0; i < sizeof(reserved) / sizeof(*reserved); ++i)
+    {
+        if (name == reserved[i])
+            return true;
+    }
+    return false;
+}
+
+//! The function makes a unique C++ identifier from the name
+std::string make_identifier(std::string const& name, std::set< std::string >& used)
+{
+    std::string id;
+    for (std::string::size_type i = 0; i < name.size(); ++i)
+    {
+        const unsigned char c = static_cast< unsigned char >(name[i]);
+        id.push_back((std::isalnum(c) || c == '_') ? static_cast< char >(c) : '_');
+    }
+    if (id.empty() || std::isdigit(static_cast< unsigned char >(id[0])) || id[0] == '_')
+        id.insert(id.begin(), 'S');
+    while (is_reserved(id) || used.count(id) != 0)
+        id.push_back('_');
+    used.insert(id);
+    return id;
+}
+
+//! The function writes the MPL sequence of the elements, the sequences longer than MAX_VECTOR_SIZE are joined
+void write_sequence(std::ostream& strm, std::vector< std::string > const& elements, std::size_t begin = 0)
+{
+    const std::size_t count = (std::min)(elements.size() - begin, static_cast< std::size_t >(MAX_VECTOR_SIZE));
+    const bool is_joined = (begin + count < elements.size());
+    if (is_joined)
+        strm << "boost::mpl::joint_view<\n";
+    strm << "boost::mpl::vector" << count << "<\n";
+    for (std::size_t i = begin; i < begin + count; ++i)
+        strm << "    " << elements[i] << (i + 1 < begin + count ? ",\n" : "\n");
+    strm << ">";
+    if (is_joined)
+    {
+        strm << ",\n";
+        write_sequence(strm, elements, begin + count);
+        strm << "\n>";
+    }
+}
+
+//! The function writes the two-dimensional table
+void write_table(std::ostream& strm, const char* type, const char* name, std::vector< std::vector< unsigned int > > const& rows)
+{
+    const std::size_t columns = rows[0].size();
+    strm << "template< typename T >\n"
+        << type << " const basic_transition_table< T >::" << name << "[" << rows.size() << "][" << columns << "] =\n{\n";
+    for (std::size_t r = 0; r < rows.size(); ++r)
+    {
+        strm << "    { ";
+        for (std::size_t c = 0; c < columns; ++c)
+            strm << rows[r][c] << (c + 1 < columns ? ", " : " ");
+        strm << (r + 1 < rows.size() ? "},\n" : "}\n");
+    }
+    strm << "};\n\n";
+}
+
+//! The function returns the smallest unsigned type that is able to hold values in range [0, count)
+inline const char* table_element_type(unsigned int count)
+{
+    return count <= 256u ? "unsigned char" : "unsigned short";
+}
+
+//! The function writes the generated header
+void generate(std::ostream& strm, definition_t const& definition, std::string const& source, std::string const& ns)
+{
+    const unsigned int states_count = definition.states_count(), events_count = definition.events_count();
+    if (events_count == 0)
+        boost::throw_exception(fsm::bad_machine_definition("no events are defined"));
+    if (states_count > 65536u)
+        boost::throw_exception(fsm::bad_machine_definition("too many states"));
+
+    std::set< std::string > used_names, used_event_names;
+    std::vector< std::string > states, events, transitions;
+    for (fsm::state_id_t s = 0; s < states_count; ++s)
+        states.push_back(make_identifier(definition.get_state_name(s), used_names));
+    for (fsm::event_id_t e = 0; e < events_count; ++e)
+        events.push_back(make_identifier(definition.get_event_name(e), used_event_names));
+
+    // The tables and the transition rules, the rules with actions get named classes
+    std::vector< std::vector< unsigned int > > next_states(states_count), actions(states_count);
+    std::vector< std::set< fsm::event_id_t > > incoming_events(states_count);
+    std::vector< std::string > action_rules;
+    unsigned int max_action_id = 0;
+    for (fsm::state_id_t s = 0; s < states_count; ++s)
+    {
+        next_states[s].resize(events_count, s);
+        actions[s].resize(events_count, 0u);
+        for (fsm::event_id_t e = 0; e < events_count; ++e)
+        {
+            definition_t::transition_type const* p = definition.find_transition(s, e);
+            if (!p)
+                continue;
+
+            // The action identifiers are stored in the table of up to 16 bit elements, see table_state_machine
+            if (p->action > 65535u)
+                boost::throw_exception(fsm::bad_machine_definition("action identifier is too large"));
+
+            next_states[s][e] = p->next_state;
+            incoming_events[p->next_state].insert(e);
+            actions[s][e] = p->action;
+            max_action_id = (std::max)(max_action_id, p->action);
+
+            std::ostringstream rule;
+            rule << "boost::fsm::transition< " << states[s] << ", events::" << events[e] << ", " << states[p->next_state] << " >";
+            if (p->action != 0)
+            {
+                std::string name = make_identifier(states[s] + "_" + events[e] + "_transition", used_names);
+                std::ostringstream action_rule;
+                action_rule << "struct " << name << " : public " << rule.str()
+                    << "\n{\n    typedef boost::mpl::int_< " << p->action << " > action_id;\n};\n";
+                action_rules.push_back(action_rule.str());
+                transitions.push_back(name);
+            }
+            else
+                transitions.push_back(rule.str());
+        }
+    }
+
+    std::string guard = "FSM_COMPILER_";
+    for (std::string::size_type i = 0; i < ns.size(); ++i)
+        guard.push_back(std::isalnum(static_cast< unsigned char >(ns[i])) ? static_cast< char >(std::toupper(static_cast< unsigned char >(ns[i]))) : '_');
+    guard += "_HPP_INCLUDED_";
+
+    strm << "/*\n * This file is generated by fsm_compiler from " << source << ". Do not edit.\n */\n\n"
+        << "#ifndef " << guard << "\n#define " << guard << "\n\n"
+        << "#include <boost/mpl/int.hpp>\n"
+        << "#include <boost/mpl/joint_view.hpp>\n"
+        << "#include <boost/mpl/vector/vector50.hpp>\n"
+        << "#include <boost/fsm/state_machine.hpp>\n"
+        << "#include <boost/fsm/transition.hpp>\n"
+        << "#include <boost/fsm/table_state_machine.hpp>\n\n"
+        << "namespace " << ns << " {\n\n";
+
+    strm << "//! Event classes\nnamespace events {\n\n";
+    for (unsigned int e = 0; e < events_count; ++e)
+        strm << "struct " << events[e] << " {};\n";
+    strm << "\n} // namespace events\n\n";
+
+    strm << "//! State classes forward\n";
+    for (unsigned int s = 0; s < states_count; ++s)
+        strm << "struct " << states[s] << ";\n";
+
+    strm << "\n//! States list, the first state is the initial one\ntypedef ";
+    write_sequence(strm, states);
+    strm << "::type states_type_list;\n\n//! Events list\ntypedef ";
+    std::vector< std::string > event_types;
+    for (unsigned int e = 0; e < events_count; ++e)
+        event_types.push_back("events::" + events[e]);
+    write_sequence(strm, event_types);
+    strm << "::type events_type_list;\n\n"
+        << "//! State classes, state_machine delivers the event to the target state of the transition\n";
+    for (unsigned int s = 0; s < states_count; ++s)
+    {
+        strm << "struct " << states[s] << " : public boost::fsm::state< " << states[s] << ", states_type_list >\n{\n";
+        for (std::set< fsm::event_id_t >::const_iterator it = incoming_events[s].begin(), end = incoming_events[s].end(); it != end; ++it)
+            strm << "    void on_process(events::" << events[*it] << " const&) {}\n";
+        strm << "};\n";
+    }
+
+    if (!action_rules.empty())
+    {
+        strm << "\n//! Transition rules with actions\n";
+        for (std::size_t i = 0; i < action_rules.size(); ++i)
+            strm << action_rules[i];
+    }
+
+    strm << "\n//! Transitions map\ntypedef ";
+    if (transitions.empty())
+        strm << "boost::mpl::vector0< >";
+    else
+        write_sequence(strm, transitions);
+    strm << "::type transitions_type_list;\n\n";
+
+    const char* const state_type = table_element_type(states_count);
+    const char* const action_type = table_element_type(max_action_id + 1u);
+    strm << "//! The prebuilt transition table, see boost::fsm::prebuilt_table\n"
+        << "template< typename T = void >\nstruct basic_transition_table\n{\n"
+        << "    static const unsigned int states_count = " << states_count << ";\n"
+        << "    static const unsigned int events_count = " << events_count << ";\n"
+        << "    static const unsigned int max_action_id = " << max_action_id << ";\n\n"
+        << "    static " << state_type << " const next_states[" << states_count << "][" << events_count << "];\n"
+        << "    static " << action_type << " const actions[" << states_count << "][" << events_count << "];\n"
+        << "};\n\n";
+    write_table(strm, state_type, "next_states", next_states);
+    write_table(strm, action_type, "actions", actions);
+    strm << "typedef basic_transition_table< > transition_table;\n\n"
+        << "//! The table state machine type\n"
+        << "typedef boost::fsm::table_state_machine<\n"
+        << "    states_type_list,\n    events_type_list,\n    boost::fsm::prebuilt_table< transition_table >\n"
+        << "> table_state_machine_type;\n\n"
+        << "} // namespace " << ns << "\n\n"
+        << "#endif // " << guard << "\n";
+}
+
+//////////////////////////////////////////////////////////////////////////
+//! Main function
+//////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::string format, ns, output, input;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--format" && i + 1 < argc)
+            format = argv[++i];
+        else if (arg == "--namespace" && i + 1 < argc)
+            ns = argv[++i];
+        else if (arg == "--output" && i + 1 < argc)
+            output = argv[++i];
+        else if (input.empty() && !arg.empty() && arg[0] != '-')
+            input = arg;
+        else
+            input.clear(), i = argc;
+    }
+    if (input.empty())
+    {
+        std::cerr << "Usage: fsm_compiler [--format scxml|csv|fsm] [--namespace name] [--output file] input" << std::endl;
+        return 1;
+    }
+
+    std::string::size_type dot = input.find_last_of('.'), slash = input.find_last_of("/\\");
+    if (slash == std::string::npos)
+        slash = 0;
+    else
+        ++slash;
+    if (format.empty() && dot != std::string::npos && dot > slash)
+        format = input.substr(dot + 1);
+    if (ns.empty())
+    {
+        std::set< std::string > used;
+        ns = make_identifier(input.substr(slash, (dot != std::string::npos && dot > slash ? dot : input.size()) - slash), used);
+    }
+
+    try
+    {
+        std::ifstream file(input.c_str());
+        if (!file.is_open())
+        {
+            std::cerr << "Could not open " << input << std::endl;
+            return 1;
+        }
+
+        definition_t definition;
+        if (format == "scxml" || format == "xml")
+            load_scxml(definition, file);
+        else if (format == "csv")
+            load_csv(definition, file);
+        else if (format == "fsm")
+            definition.load(file);
+        else
+        {
+            std::cerr << "Unknown input format '" << format << "'" << std::endl;
+            return 1;
+        }
+
+        if (output.empty())
+        {
+            generate(std::cout, definition, input.substr(slash), ns);
+        }
+        else
+        {
+            std::ofstream out(output.c_str());
+            if (!out.is_open())
+            {
+                std::cerr << "Could not open " << output << std::endl;
+                return 1;
+            }
+            generate(out, definition, input.substr(slash), ns);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << input << ": " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+/*!
+* (C) 2026 Andrey Semashev
+*
+* Use, modification and distribution is subject to the Boost Software License, Version 1.0.
+* (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*
+* \file   turnstile_check.cpp
+* \author Andrey Semashev
+* \date   18.10.2026
+*
+* \brief  The check of the header generated by fsm_compiler from turnstile.scxml
+*
+* The generated header must compile and the machines built from it must behave as the specification says.
+*/
+
+#include <boost/static_assert.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/fsm/state_machine.hpp>
+#include <boost/fsm/transition.hpp>
+#include <boost/fsm/table_state_machine.hpp>
+#include "turnstile.hpp"
+
+using namespace turnstile;
+
+BOOST_STATIC_ASSERT(boost::mpl::size< states_type_list >::value == 3);
+BOOST_STATIC_ASSERT(boost::mpl::size< events_type_list >::value == 4);
+BOOST_STATIC_ASSERT(transition_table::states_count == 3);
+BOOST_STATIC_ASSERT(transition_table::events_count == 4);
+
+//! The function checks the machine driven by the prebuilt table
+int check_table_machine()
+{
+    table_state_machine_type fsm;
+    if (!fsm.is_in_state< Locked >())
+        return 1;
+    fsm.process(events::push());
+    fsm.process(events::coin());
+    if (!fsm.is_in_state< Unlocked >())
+        return 2;
+    fsm.process(events::push());
+    fsm.process(events::fail());
+    if (!fsm.is_in_state< Broken >())
+        return 3;
+    fsm.process(events::repair());
+    return fsm.is_in_state< Locked >() ? 0 : 4;
+}
+
+//! The function checks the state machine built from the generated lists
+int check_state_machine()
+{
+    typedef boost::fsm::state_machine< states_type_list, void, transitions_type_list > state_machine_type;
+    state_machine_type fsm;
+    fsm.process(events::coin());
+    if (!fsm.is_in_state< Unlocked >())
+        return 5;
+    fsm.process(events::push());
+    return fsm.is_in_state< Locked >() ? 0 : 6;
+}
+
+int main()
+{
+    int result = check_table_machine();
+    if (result == 0)
+        result = check_state_machine();
+    return result;
+}